@@ -1830,53 +1830,31 @@ static bool AirportMove(Aircraft *v, const AirportFTAClass *apc)
 
 	v->previous_pos = v->pos; // save previous location
 
-	/* there is only one choice to move to */
-	if (current->next == nullptr) {
-		if (AirportSetBlocks(v, current, apc)) {
-			v->pos = current->next_position;
+	/* take the only choice, or the first one that matches our heading */
+	const AirportFTA *route = apc->GetRoute(v->pos, v->state);
+	if (route != nullptr) {
+		if (AirportSetBlocks(v, route, apc)) {
+			v->pos = route->next_position;
 			UpdateAircraftCache(v);
 		} // move to next position
 		return false;
 	}
 
-	/* there are more choices to choose from, choose the one that
-	 * matches our heading */
-	do {
-		if (v->state == current->heading || current->heading == TO_ALL) {
-			if (AirportSetBlocks(v, current, apc)) {
-				v->pos = current->next_position;
-				UpdateAircraftCache(v);
-			} // move to next position
-			return false;
-		}
-		current = current->next.get();
-	} while (current != nullptr);
-
 	Debug(misc, 0, "[Ap] cannot move further on Airport! (pos {} state {}) for vehicle {}", v->pos, v->state, v->index);
 	NOT_REACHED();
 }
 
 /** returns true if the road ahead is busy, eg. you must wait before proceeding. */
-static bool AirportHasBlock(Aircraft *v, const AirportFTA *current_pos, const AirportFTAClass *apc)
+static bool AirportHasBlock(Aircraft *v, const AirportFTA *current_pos, const AirportFTAClass *)
 {
-	const AirportFTA *reference = &apc->layout[v->pos];
-	const AirportFTA *next = &apc->layout[current_pos->next_position];
-
-	/* same block, then of course we can move */
-	if (apc->layout[current_pos->position].blocks != next->blocks) {
-		const Station *st = Station::Get(v->targetairport);
-		AirportBlocks blocks = next->blocks;
+	/* the blocks to check are precomputed; none when staying in the same block */
+	if (current_pos->wait_blocks.None()) return false;
 
-		/* check additional possible extra blocks */
-		if (current_pos != reference && current_pos->blocks != AirportBlock::Nothing) {
-			blocks.Set(current_pos->blocks);
-		}
-
-		if (st->airport.blocks.Any(blocks)) {
-			v->cur_speed = 0;
-			v->subspeed = 0;
-			return true;
-		}
+	const Station *st = Station::Get(v->targetairport);
+	if (st->airport.blocks.Any(current_pos->wait_blocks)) {
+		v->cur_speed = 0;
+		v->subspeed = 0;
+		return true;
 	}
 	return false;
 }
@@ -1888,102 +1866,60 @@ static bool AirportHasBlock(Aircraft *v, const AirportFTA *current_pos, const Ai
  * @param apc airport on which block is requested to be set
  * @returns true on success. Eg, next block was free and we have occupied it
  */
-static bool AirportSetBlocks(Aircraft *v, const AirportFTA *current_pos, const AirportFTAClass *apc)
-{
-	const AirportFTA *next = &apc->layout[current_pos->next_position];
-	const AirportFTA *reference = &apc->layout[v->pos];
-
-	/* if the next position is in another block, check it and wait until it is free */
-	if (!apc->layout[current_pos->position].blocks.All(next->blocks)) {
-		AirportBlocks blocks = next->blocks;
-		/* search for all all elements in the list with the same state, and blocks != N
-		 * this means more blocks should be checked/set */
-		const AirportFTA *current = current_pos;
-		if (current == reference) current = current->next.get();
-		while (current != nullptr) {
-			if (current->heading == current_pos->heading && current->blocks.Any()) {
-				blocks.Set(current->blocks);
-				break;
-			}
-			current = current->next.get();
-		}
-
-		/* if the block to be checked is in the next position, then exclude that from
-		 * checking, because it has been set by the airplane before */
-		if (current_pos->blocks == next->blocks) blocks.Flip(next->blocks);
+static bool AirportSetBlocks(Aircraft *v, const AirportFTA *current_pos, const AirportFTAClass *)
+{
+	/* if the next position is in another block, check it and wait until it is free;
+	 * which blocks to check and occupy is precomputed with the state machine */
+	if (current_pos->reserve_blocks.None()) return true;
 
-		Station *st = Station::Get(v->targetairport);
-		if (st->airport.blocks.Any(blocks)) {
-			v->cur_speed = 0;
-			v->subspeed = 0;
-			return false;
-		}
+	Station *st = Station::Get(v->targetairport);
+	if (st->airport.blocks.Any(current_pos->reserve_blocks)) {
+		v->cur_speed = 0;
+		v->subspeed = 0;
+		return false;
+	}
 
-		if (next->blocks != AirportBlock::Nothing) {
-			st->airport.blocks.Set(blocks); // occupy next block
-		}
+	if (current_pos->reserve_occupies) {
+		st->airport.blocks.Set(current_pos->reserve_blocks); // occupy next block
 	}
 	return true;
 }
 
-/**
- * Combination of aircraft state for going to a certain terminal and the
- * airport flag for that terminal block.
- */
-struct MovementTerminalMapping {
-	AirportMovementStates state; ///< Aircraft movement state when going to this terminal.
-	AirportBlock blocks; ///< Bitmask in the airport flags that need to be free for this terminal.
+/** Aircraft movement state for going to each terminal and helipad, by their number; see #TERMINAL_BLOCKS. */
+static constexpr AirportMovementStates _airport_terminal_states[] = {
+	TERM1, TERM2, TERM3, TERM4, TERM5, TERM6, TERM7, TERM8,
+	HELIPAD1, HELIPAD2, HELIPAD3,
 };
+static_assert(lengthof(_airport_terminal_states) == TERMINAL_BLOCKS.size());
 
-/** A list of all valid terminals and their associated blocks. */
-static const MovementTerminalMapping _airport_terminal_mapping[] = {
-	{TERM1, AirportBlock::Term1},
-	{TERM2, AirportBlock::Term2},
-	{TERM3, AirportBlock::Term3},
-	{TERM4, AirportBlock::Term4},
-	{TERM5, AirportBlock::Term5},
-	{TERM6, AirportBlock::Term6},
-	{TERM7, AirportBlock::Term7},
-	{TERM8, AirportBlock::Term8},
-	{HELIPAD1, AirportBlock::Helipad1},
-	{HELIPAD2, AirportBlock::Helipad2},
-	{HELIPAD3, AirportBlock::Helipad3},
-};
+/* Terminals, and helipads, are numbered in the order of their blocks, so the lowest free block is the first free one. */
+static_assert(std::ranges::is_sorted(TERMINAL_BLOCKS.begin(), TERMINAL_BLOCKS.begin() + MAX_TERMINALS));
+static_assert(std::ranges::is_sorted(TERMINAL_BLOCKS.begin() + MAX_TERMINALS, TERMINAL_BLOCKS.end()));
+
+/** Aircraft movement state for going to the terminal or helipad of each block. */
+static constexpr auto _airport_terminal_block_states = []() {
+	std::array<AirportMovementStates, std::numeric_limits<AirportBlocks::BaseType>::digits> states{};
+	for (size_t i = 0; i < TERMINAL_BLOCKS.size(); i++) states[to_underlying(TERMINAL_BLOCKS[i])] = _airport_terminal_states[i];
+	return states;
+}();
 
 /**
- * Find a free terminal or helipad, and if available, assign it.
+ * Find the first free terminal or helipad, and if available, assign it.
  * @param v Aircraft looking for a free terminal or helipad.
- * @param i First terminal to examine.
- * @param last_terminal Terminal number to stop examining.
+ * @param candidates Blocks of the terminals or helipads to examine.
  * @return A terminal or helipad has been found, and has been assigned to the aircraft.
  */
-static bool FreeTerminal(Aircraft *v, uint8_t i, uint8_t last_terminal)
+static bool FreeTerminal(Aircraft *v, AirportBlocks candidates)
 {
-	assert(last_terminal <= lengthof(_airport_terminal_mapping));
 	Station *st = Station::Get(v->targetairport);
-	for (; i < last_terminal; i++) {
-		if (!st->airport.blocks.Any(_airport_terminal_mapping[i].blocks)) {
-			/* TERMINAL# HELIPAD# */
-			v->state = _airport_terminal_mapping[i].state; // start moving to that terminal/helipad
-			st->airport.blocks.Set(_airport_terminal_mapping[i].blocks); // occupy terminal/helipad
-			return true;
-		}
-	}
-	return false;
-}
+	candidates.Reset(st->airport.blocks);
+	if (candidates.None()) return false;
 
-/**
- * Get the number of terminals at the airport.
- * @param apc Airport description.
- * @return Number of terminals.
- */
-static uint GetNumTerminals(const AirportFTAClass *apc)
-{
-	uint num = 0;
-
-	for (uint i = apc->terminals[0]; i > 0; i--) num += apc->terminals[i];
-
-	return num;
+	AirportBlock block = static_cast<AirportBlock>(FindFirstBit(candidates.base()));
+	/* TERMINAL# HELIPAD# */
+	v->state = _airport_terminal_block_states[to_underlying(block)]; // start moving to that terminal/helipad
+	st->airport.blocks.Set(block); // occupy terminal/helipad
+	return true;
 }
 
 /**
@@ -2004,39 +1940,14 @@ static bool AirportFindFreeTerminal(Aircraft *v, const AirportFTAClass *apc)
 	 * possible groups are checked (in this case group 1, since that is after group 0). If that
 	 * fails, then attempt fails and plane waits
 	 */
-	if (apc->terminals[0] > 1) {
-		const Station *st = Station::Get(v->targetairport);
-		const AirportFTA *temp = apc->layout[v->pos].next.get();
-
-		while (temp != nullptr) {
-			if (temp->heading == TERMGROUP) {
-				if (!st->airport.blocks.Any(temp->blocks)) {
-					/* read which group do we want to go to?
-					 * (the first free group) */
-					uint target_group = temp->next_position + 1;
-
-					/* at what terminal does the group start?
-					 * that means, sum up all terminals of
-					 * groups with lower number */
-					uint group_start = 0;
-					for (uint i = 1; i < target_group; i++) {
-						group_start += apc->terminals[i];
-					}
-
-					uint group_end = group_start + apc->terminals[target_group];
-					if (FreeTerminal(v, group_start, group_end)) return true;
-				}
-			} else {
-				/* once the heading isn't 255, we've exhausted the possible blocks.
-				 * So we cannot move */
-				return false;
-			}
-			temp = temp->next.get();
-		}
+	const Station *st = Station::Get(v->targetairport);
+	const AirportTerminalGroupChoices &choices = apc->GetTerminalGroupChoices(v->pos);
+	for (const auto &[group_blocks, terminal_blocks] : choices.groups) {
+		if (!st->airport.blocks.Any(group_blocks) && FreeTerminal(v, terminal_blocks)) return true;
 	}
 
 	/* if there is only 1 terminalgroup, all terminals are checked (starting from 0 to max) */
-	return FreeTerminal(v, 0, GetNumTerminals(apc));
+	return choices.any_terminal && FreeTerminal(v, apc->GetTerminalBlocks());
 }
 
 /**
@@ -2050,9 +1961,8 @@ static bool AirportFindFreeHelipad(Aircraft *v, const AirportFTAClass *apc)
 	/* if an airport doesn't have helipads, use terminals */
 	if (apc->num_helipads == 0) return AirportFindFreeTerminal(v, apc);
 
-	/* only 1 helicoptergroup, check all helipads
-	 * The blocks for helipads start after the last terminal (MAX_TERMINALS) */
-	return FreeTerminal(v, MAX_TERMINALS, apc->num_helipads + MAX_TERMINALS);
+	/* only 1 helicoptergroup, check all helipads */
+	return FreeTerminal(v, apc->GetHelipadBlocks());
 }
 
 /**
@@ -128,6 +128,99 @@ AirportFTAClass::AirportFTAClass(
 {
 	/* Build the state machine itself */
 	AirportBuildAutomata(this->layout, this->nofelements, apFA);
+	this->PrecomputeRoutes();
+}
+
+/**
+ * Precompute the decisions aircraft make while moving over the airport, which
+ * only depend on the layout of the state machine. This way moving an aircraft
+ * does not need to search the movement choices of a position every tick.
+ */
+void AirportFTAClass::PrecomputeRoutes()
+{
+	this->routes.resize(this->nofelements);
+	for (uint8_t pos = 0; pos < this->nofelements; pos++) {
+		const AirportFTA *head = &this->layout[pos];
+
+		/* The first choice matching the heading wins. With only a single choice it is always taken. */
+		for (uint8_t state = 0; state <= MAX_HEADINGS; state++) {
+			const AirportFTA *route = head->next == nullptr ? head : nullptr;
+			for (const AirportFTA *current = head; route == nullptr && current != nullptr; current = current->next.get()) {
+				if (state == current->heading || current->heading == TO_ALL) route = current;
+			}
+			this->routes[pos][state] = route;
+		}
+
+		for (AirportFTA *current = &this->layout[pos]; current != nullptr; current = current->next.get()) {
+			const AirportFTA *next = &this->layout[current->next_position];
+
+			/* Blocks to wait for; when staying in the same block we can always move. */
+			current->wait_blocks = {};
+			if (this->layout[current->position].blocks != next->blocks) {
+				current->wait_blocks = next->blocks;
+				/* Choices other than the first also check their own blocks. */
+				if (current != head && current->blocks != AirportBlock::Nothing) current->wait_blocks.Set(current->blocks);
+			}
+
+			/* Blocks to reserve; when the next position is in the same block it is already ours. */
+			current->reserve_blocks = {};
+			current->reserve_occupies = false;
+			if (!this->layout[current->position].blocks.All(next->blocks)) {
+				AirportBlocks blocks = next->blocks;
+				/* Search for all elements in the list with the same heading and blocks != N,
+				 * this means more blocks should be checked/set. */
+				for (const AirportFTA *other = (current == head) ? current->next.get() : current; other != nullptr; other = other->next.get()) {
+					if (other->heading == current->heading && other->blocks.Any()) {
+						blocks.Set(other->blocks);
+						break;
+					}
+				}
+
+				/* If the block to be checked is in the next position, then exclude that from
+				 * checking, because it has been set by the airplane before. */
+				if (current->blocks == next->blocks) blocks.Flip(next->blocks);
+
+				current->reserve_blocks = blocks;
+				current->reserve_occupies = next->blocks != AirportBlock::Nothing;
+			}
+		}
+	}
+
+	/* Blocks of the helipads and terminals, so a free one can be found with a few bit operations. */
+	assert(this->num_helipads <= MAX_HELIPADS);
+	this->helipad_blocks = {};
+	for (uint8_t i = 0; i < this->num_helipads; i++) this->helipad_blocks.Set(TERMINAL_BLOCKS[MAX_TERMINALS + i]);
+
+	this->terminal_blocks = {};
+	this->terminal_group_choices.assign(this->nofelements, {});
+	if (this->terminals == nullptr) return;
+
+	/* Blocks of the terminals of each terminal group; terminals[0] holds the number of groups. */
+	std::vector<AirportBlocks> group_blocks(this->terminals[0] + 1);
+	uint8_t terminal = 0;
+	for (uint8_t group = 1; group <= this->terminals[0]; group++) {
+		for (uint8_t i = 0; i < this->terminals[group]; i++) {
+			assert(terminal < MAX_TERMINALS);
+			group_blocks[group].Set(TERMINAL_BLOCKS[terminal++]);
+		}
+		this->terminal_blocks.Set(group_blocks[group]);
+	}
+
+	/* With multiple groups, the choices following a position list the groups to try in order.
+	 * Once a choice is not a terminal group, the aircraft must wait for one of those groups. */
+	if (this->terminals[0] <= 1) return;
+	for (uint8_t pos = 0; pos < this->nofelements; pos++) {
+		AirportTerminalGroupChoices &choices = this->terminal_group_choices[pos];
+		for (const AirportFTA *current = this->layout[pos].next.get(); current != nullptr; current = current->next.get()) {
+			if (current->heading != TERMGROUP) {
+				choices.any_terminal = false;
+				break;
+			}
+			uint8_t group = current->next_position + 1;
+			assert(group <= this->terminals[0]);
+			choices.groups.emplace_back(current->blocks, group_blocks[group]);
+		}
+	}
 }
 
 /**
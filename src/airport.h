@@ -132,6 +132,13 @@ enum class AirportBlock : uint8_t {
 };
 using AirportBlocks = EnumBitSet<AirportBlock, uint64_t>;
 
+/** Blocks of the terminals and helipads by their number; the helipads follow the #MAX_TERMINALS terminals. */
+static constexpr std::array<AirportBlock, MAX_TERMINALS + MAX_HELIPADS> TERMINAL_BLOCKS = {
+	AirportBlock::Term1, AirportBlock::Term2, AirportBlock::Term3, AirportBlock::Term4,
+	AirportBlock::Term5, AirportBlock::Term6, AirportBlock::Term7, AirportBlock::Term8,
+	AirportBlock::Helipad1, AirportBlock::Helipad2, AirportBlock::Helipad3,
+};
+
 /** A single location on an airport where aircraft can move to. */
 struct AirportMovingData {
 	int16_t x;             ///< x-coordinate of the destination.
@@ -153,6 +160,17 @@ struct AirportFTA {
 	uint8_t position; ///< the position that an airplane is at
 	uint8_t next_position; ///< next position from this position
 	uint8_t heading; ///< heading (current orders), guiding an airplane to its target on an airport
+
+	/* Precomputed when building the state machine, see AirportFTAClass::PrecomputeRoutes(). */
+	AirportBlocks wait_blocks{}; ///< Blocks that must be free before moving on to the next position.
+	AirportBlocks reserve_blocks{}; ///< Blocks that must be free, and are then occupied, when moving on to the next position.
+	bool reserve_occupies = false; ///< Whether #reserve_blocks are occupied after checking them.
+};
+
+/** Terminal groups an aircraft can choose from at a position, see AirportFTAClass::PrecomputeRoutes(). */
+struct AirportTerminalGroupChoices {
+	std::vector<std::pair<AirportBlocks, AirportBlocks>> groups; ///< In order of preference the block to enter a terminal group and the blocks of its terminals.
+	bool any_terminal = true; ///< Whether any terminal may be taken when no group has a free terminal.
 };
 
 /** Finite sTate mAchine (FTA) of an airport. */
@@ -187,6 +205,49 @@ public:
 		return &moving_data[position];
 	}
 
+	/**
+	 * Get the movement choice an aircraft takes from a position.
+	 * @param position Element number the aircraft is at.
+	 * @param state Current state (heading) of the aircraft.
+	 * @return The movement choice to take, or \c nullptr if the aircraft cannot move further.
+	 */
+	const AirportFTA *GetRoute(uint8_t position, uint8_t state) const
+	{
+		assert(position < nofelements);
+		if (state <= MAX_HEADINGS) return this->routes[position][state];
+
+		/* Not a regular heading, so search the choices the slow way. */
+		const AirportFTA *current = &this->layout[position];
+		if (current->next == nullptr) return current;
+		for (; current != nullptr; current = current->next.get()) {
+			if (current->heading == state || current->heading == TO_ALL) return current;
+		}
+		return nullptr;
+	}
+
+	/**
+	 * Get the terminal groups an aircraft can choose from at a position.
+	 * @param position Element number the aircraft is at.
+	 * @return The terminal groups to choose from.
+	 */
+	const AirportTerminalGroupChoices &GetTerminalGroupChoices(uint8_t position) const
+	{
+		assert(position < nofelements);
+		return this->terminal_group_choices[position];
+	}
+
+	/**
+	 * Get the blocks of all terminals.
+	 * @return The blocks of the terminals.
+	 */
+	AirportBlocks GetTerminalBlocks() const { return this->terminal_blocks; }
+
+	/**
+	 * Get the blocks of all helipads.
+	 * @return The blocks of the helipads.
+	 */
+	AirportBlocks GetHelipadBlocks() const { return this->helipad_blocks; }
+
 	const AirportMovingData *moving_data; ///< Movement data.
 	std::vector<AirportFTA> layout; ///< state machine for airport
 	const uint8_t *terminals;                ///< %Array with the number of terminal groups, followed by the number of terminals in each group.
@@ -195,6 +256,14 @@ public:
 	uint8_t nofelements;                     ///< number of positions the airport consists of
 	const uint8_t *entry_points;             ///< when an airplane arrives at this airport, enter it at position entry_point, index depends on direction
 	uint8_t delta_z;                         ///< Z adjustment for helicopter pads
+
+private:
+	std::vector<std::array<const AirportFTA *, MAX_HEADINGS + 1>> routes; ///< Per position and heading the movement choice to take.
+	std::vector<AirportTerminalGroupChoices> terminal_group_choices; ///< Per position the terminal groups to choose from.
+	AirportBlocks terminal_blocks{}; ///< Blocks of all terminals.
+	AirportBlocks helipad_blocks{}; ///< Blocks of all helipads.
+
+	void PrecomputeRoutes();
 };
 
 
@@ -18,6 +18,7 @@
 #include "station_base.h"
 #include "station_map.h"
 #include "subsidy_func.h"
+#include "timer/timer_game_tick.h"
 #include "town.h"
 #include "train.h"
 #include "vehicle_base.h"
@@ -28,18 +29,34 @@ extern void AfterLoadCompanyStats();
 extern void RebuildTownCaches();
 
 /**
- * Check the validity of some of the caches.
- * Especially in the sense of desyncs between
- * the cached value and what the value would
- * be when calculated from the 'base' data.
+ * Number of ticks over which the checks of the caches of individual
+ * vehicles, road stops and stations are spread, and after which the
+ * caches that can only be rebuilt as a whole are checked.
  */
-void CheckCaches()
-{
-	/* Return here so it is easy to add checks that are run
-	 * always to aid testing of caches. */
-	if (_debug_desync_level <= 1) return;
+static constexpr uint CACHE_CHECK_INTERVAL = Ticks::DAY_TICKS;
+
+/**
+ * Selection of the objects whose caches are checked in this tick.
+ */
+struct CacheCheckSlice {
+	bool full; ///< Whether all objects are checked.
+	uint slice; ///< The objects whose index modulo #CACHE_CHECK_INTERVAL equals this are checked.
 
-	/* Check the town caches. */
+	/**
+	 * Whether the object with the given index is to be checked.
+	 * @param index The pool index of the object.
+	 * @return True iff its caches are to be checked.
+	 */
+	template <typename T>
+	bool Contains(T index) const
+	{
+		return this->full || index.base() % CACHE_CHECK_INTERVAL == this->slice;
+	}
+};
+
+/** Check the town caches, which can only be rebuilt for all towns at once. */
+static void CheckTownCaches()
+{
 	std::vector<TownCache> old_town_caches;
 	for (const Town *t : Town::Iterate()) {
 		old_town_caches.push_back(t->cache);
@@ -55,29 +72,46 @@ void CheckCaches()
 		}
 		i++;
 	}
+}
 
-	/* Check company infrastructure cache. */
+/** Check the company infrastructure caches, which can only be rebuilt for all companies at once. */
+static void CheckInfrastructureCaches()
+{
 	std::vector<CompanyInfrastructure> old_infrastructure;
 	for (const Company *c : Company::Iterate()) old_infrastructure.push_back(c->infrastructure);
 
 	AfterLoadCompanyStats();
 
-	i = 0;
+	uint i = 0;
 	for (const Company *c : Company::Iterate()) {
 		if (old_infrastructure[i] != c->infrastructure) {
 			Debug(desync, 2, "warning: infrastructure cache mismatch: company {}", c->index);
 		}
 		i++;
 	}
+}
 
-	/* Strict checking of the road stop cache entries */
+/**
+ * Strict checking of the road stop cache entries.
+ * @param selection The road stops to check.
+ */
+static void CheckRoadStopCaches(const CacheCheckSlice &selection)
+{
 	for (const RoadStop *rs : RoadStop::Iterate()) {
+		if (!selection.Contains(rs->index)) continue;
 		if (IsBayRoadStopTile(rs->xy)) continue;
 
 		rs->GetEntry(DIAGDIR_NE).CheckIntegrity(rs);
 		rs->GetEntry(DIAGDIR_NW).CheckIntegrity(rs);
 	}
+}
 
+/**
+ * Check the caches of vehicles, including the ones of their cargo.
+ * @param selection The vehicles to check; a chain is checked when its front is selected.
+ */
+static void CheckVehicleCaches(const CacheCheckSlice &selection)
+{
 	std::vector<NewGRFCache> grf_cache;
 	std::vector<VehicleCache> veh_cache;
 	std::vector<GroundVehicleCache> gro_cache;
@@ -85,6 +119,7 @@ void CheckCaches()
 
 	for (Vehicle *v : Vehicle::Iterate()) {
 		if (v != v->First() || v->vehstatus.Test(VehState::Crashed) || !v->IsPrimaryVehicle()) continue;
+		if (!selection.Contains(v->index)) continue;
 
 		for (const Vehicle *u = v; u != nullptr; u = u->Next()) {
 			FillNewGRFVehicleCache(u);
@@ -103,6 +138,20 @@ void CheckCaches()
 			}
 		}
 
+		switch (v->type) {
+			case VEH_TRAIN:
+				if (Train::From(v)->acache.slope_resistance_valid && Train::From(v)->acache.slope_resistance != Train::From(v)->CalcSlopeResistance()) {
+					Debug(desync, 2, "warning: train slope resistance cache mismatch: vehicle {}, company {}, unit number {}", v->index, v->owner, v->unitnumber);
+				}
+				break;
+			case VEH_ROAD:
+				if (RoadVehicle::From(v)->acache.slope_resistance_valid && RoadVehicle::From(v)->acache.slope_resistance != RoadVehicle::From(v)->CalcSlopeResistance()) {
+					Debug(desync, 2, "warning: road vehicle slope resistance cache mismatch: vehicle {}, company {}, unit number {}", v->index, v->owner, v->unitnumber);
+				}
+				break;
+			default: break;
+		}
+
 		switch (v->type) {
 			case VEH_TRAIN:    Train::From(v)->ConsistChanged(CCF_TRACK); break;
 			case VEH_ROAD:     RoadVehUpdateCache(RoadVehicle::From(v)); break;
@@ -146,8 +195,10 @@ void CheckCaches()
 		tra_cache.clear();
 	}
 
-	/* Check whether the caches are still valid */
+	/* Check whether the cargo caches are still valid */
 	for (Vehicle *v : Vehicle::Iterate()) {
+		if (!selection.Contains(v->index)) continue;
+
 		[[maybe_unused]] const auto a = v->cargo.PeriodsInTransit();
 		[[maybe_unused]] const auto b = v->cargo.TotalCount();
 		[[maybe_unused]] const auto c = v->cargo.GetFeederShare();
@@ -156,18 +207,17 @@ void CheckCaches()
 		assert(b == v->cargo.TotalCount());
 		assert(c == v->cargo.GetFeederShare());
 	}
+}
 
-	/* Backup stations_near */
-	std::vector<StationList> old_town_stations_near;
-	for (Town *t : Town::Iterate()) old_town_stations_near.push_back(t->stations_near);
-
-	std::vector<StationList> old_industry_stations_near;
-	for (Industry *ind : Industry::Iterate()) old_industry_stations_near.push_back(ind->stations_near);
-
-	std::vector<IndustryList> old_station_industries_near;
-	for (Station *st : Station::Iterate()) old_station_industries_near.push_back(st->industries_near);
-
+/**
+ * Check the caches of the cargo and docking tiles of stations.
+ * @param selection The stations to check.
+ */
+static void CheckStationCaches(const CacheCheckSlice &selection)
+{
 	for (Station *st : Station::Iterate()) {
+		if (!selection.Contains(st->index)) continue;
+
 		for (GoodsEntry &ge : st->goods) {
 			if (!ge.HasData()) continue;
 
@@ -196,11 +246,25 @@ void CheckCaches()
 			}
 		}
 	}
+}
+
+/** Check the catchment caches of stations, towns and industries, which can only be rebuilt for all of them at once. */
+static void CheckCatchmentCaches()
+{
+	/* Backup stations_near */
+	std::vector<StationList> old_town_stations_near;
+	for (Town *t : Town::Iterate()) old_town_stations_near.push_back(t->stations_near);
+
+	std::vector<StationList> old_industry_stations_near;
+	for (Industry *ind : Industry::Iterate()) old_industry_stations_near.push_back(ind->stations_near);
+
+	std::vector<IndustryList> old_station_industries_near;
+	for (Station *st : Station::Iterate()) old_station_industries_near.push_back(st->industries_near);
 
 	Station::RecomputeCatchmentForAll();
 
 	/* Check industries_near */
-	i = 0;
+	uint i = 0;
 	for (Station *st : Station::Iterate()) {
 		if (st->industries_near != old_station_industries_near[i]) {
 			Debug(desync, 2, "warning: station industries near mismatch: station {}", st->index);
@@ -224,3 +288,36 @@ void CheckCaches()
 		i++;
 	}
 }
+
+/**
+ * Check the validity of some of the caches.
+ * Especially in the sense of desyncs between
+ * the cached value and what the value would
+ * be when calculated from the 'base' data.
+ *
+ * Unless the desync debug level is 4 or higher, the caches of
+ * individual vehicles, road stops and stations are checked for a
+ * different slice of them each tick and the other caches every
+ * #CACHE_CHECK_INTERVAL ticks, so the checks can be left enabled
+ * on large games.
+ */
+void CheckCaches()
+{
+	/* Return here so it is easy to add checks that are run
+	 * always to aid testing of caches. */
+	if (_debug_desync_level <= 1) return;
+
+	const uint slice = TimerGameTick::counter % CACHE_CHECK_INTERVAL;
+	const CacheCheckSlice selection{_debug_desync_level >= 4, slice};
+
+	if (selection.full || slice == 0) {
+		CheckTownCaches();
+		CheckInfrastructureCaches();
+	}
+
+	CheckRoadStopCaches(selection);
+	CheckVehicleCaches(selection);
+	CheckStationCaches(selection);
+
+	if (selection.full || slice == 0) CheckCatchmentCaches();
+}
@@ -24,6 +24,7 @@
 #include "settings_func.h"
 #include "fios.h"
 #include "fileio_func.h"
+#include "framerate_type.h"
 #include "fontcache.h"
 #include "screenshot.h"
 #include "genworld.h"
@@ -45,6 +46,7 @@
 #include "3rdparty/fmt/chrono.h"
 #include "company_cmd.h"
 #include "misc_cmd.h"
+#include "sampling_profiler.h"
 
 #include "table/strings.h"
 
@@ -1255,7 +1257,6 @@ static bool ConReturn(std::span<std::string_view> argv)
 extern bool CloseConsoleLogIfActive();
 extern std::span<const GRFFile> GetAllGRFFiles();
 extern void ConPrintFramerate(); // framerate_gui.cpp
-extern void ShowFramerateWindow();
 
 static bool ConScript(std::span<std::string_view> argv)
 {
@@ -2670,6 +2671,93 @@ static bool ConFramerate(std::span<std::string_view> argv)
 	return true;
 }
 
+static bool ConProfile(std::span<std::string_view> argv)
+{
+	if (argv.empty()) {
+		IConsolePrint(CC_HELP, "Sample the stacks of all threads. Usage: 'profile start [<samples per second>]' or 'profile stop [<filename>]'.");
+		IConsolePrint(CC_HELP, "The stacks are written in the folded format, which can be turned into a flame graph. The default is 1000 samples per second of CPU time.");
+		IConsolePrint(CC_HELP, "The file is written into the save directory.");
+		return true;
+	}
+
+	if (!IsSamplingProfilerSupported()) {
+		IConsolePrint(CC_ERROR, "Sampling is not supported on this platform.");
+		return true;
+	}
+
+	if ((argv.size() == 2 || argv.size() == 3) && argv[1] == "start") {
+		if (IsSamplingProfilerActive()) {
+			IConsolePrint(CC_ERROR, "The profiler is already running.");
+			return true;
+		}
+
+		auto rate = argv.size() == 3 ? ParseInteger<uint32_t>(argv[2]) : 1000;
+		if (!rate.has_value() || !IsInsideMM(*rate, 1, 100001)) {
+			IConsolePrint(CC_ERROR, "The number of samples per second must be between 1 and 100000.");
+			return true;
+		}
+
+		if (!StartSamplingProfiler(std::chrono::microseconds(1000000 / *rate))) {
+			IConsolePrint(CC_ERROR, "Could not start the profiler.");
+			return true;
+		}
+		IConsolePrint(CC_INFO, "Started the profiler with {} samples per second.", *rate);
+		return true;
+	}
+
+	if ((argv.size() == 2 || argv.size() == 3) && argv[1] == "stop") {
+		if (!IsSamplingProfilerActive()) {
+			IConsolePrint(CC_ERROR, "The profiler is not running.");
+			return true;
+		}
+
+		std::string filename{argv.size() == 3 ? argv[2] : "openttd_profile.folded"};
+		auto stats = StopSamplingProfiler(filename);
+		if (!stats.has_value()) {
+			IConsolePrint(CC_ERROR, "Could not write the profile to '{}' in the save directory.", filename);
+			return true;
+		}
+		IConsolePrint(CC_INFO, "Written {} samples of {} distinct stacks to '{}' in the save directory; {} samples were dropped.", stats->samples, stats->stacks, stats->filename, stats->dropped);
+		return true;
+	}
+
+	return false;
+}
+
+static bool ConTrace(std::span<std::string_view> argv)
+{
+	if (argv.empty()) {
+		IConsolePrint(CC_HELP, "Record a trace of the game loop phases and threads. Usage: 'trace start' or 'trace stop [<filename>]'.");
+		IConsolePrint(CC_HELP, "The trace is written in the Chrome trace event format, which can be viewed with Perfetto or about://tracing in Chrome.");
+		IConsolePrint(CC_HELP, "The file is written into the save directory.");
+		return true;
+	}
+
+	if (argv.size() == 2 && argv[1] == "start") {
+		StartPerformanceTrace();
+		IConsolePrint(CC_INFO, "Started recording a trace.");
+		return true;
+	}
+
+	if ((argv.size() == 2 || argv.size() == 3) && argv[1] == "stop") {
+		if (!IsPerformanceTraceActive()) {
+			IConsolePrint(CC_ERROR, "No trace is being recorded.");
+			return true;
+		}
+
+		std::string filename{argv.size() == 3 ? argv[2] : "openttd_trace.json"};
+		auto count = StopPerformanceTrace(filename);
+		if (!count.has_value()) {
+			IConsolePrint(CC_ERROR, "Could not write trace to '{}' in the save directory.", filename);
+			return true;
+		}
+		IConsolePrint(CC_INFO, "Written {} trace events to '{}' in the save directory.", *count, filename);
+		return true;
+	}
+
+	return false;
+}
+
 static bool ConFramerateWindow(std::span<std::string_view> argv)
 {
 	if (argv.empty()) {
@@ -3002,6 +3090,8 @@ void IConsoleStdLibRegister()
 #endif
 	IConsole::CmdRegister("fps",                     ConFramerate);
 	IConsole::CmdRegister("fps_wnd",                 ConFramerateWindow);
+	IConsole::CmdRegister("trace",                   ConTrace);
+	IConsole::CmdRegister("profile",                 ConProfile);
 
 	/* NewGRF development stuff */
 	IConsole::CmdRegister("reload_newgrfs",          ConNewGRFReload,     ConHookNewGRFDeveloperTool);
@@ -1012,6 +1012,19 @@ void SanitizeFilename(std::string &filename)
 	}
 }
 
+/**
+ * Get the name of a file without any path, with all illegal characters removed.
+ * Use this for names from the user of files that must stay within a given directory.
+ * @param filename The name of the file, possibly with a path.
+ * @return The sanitized name of the file, or an empty string if there is none.
+ */
+std::string GetSanitizedFileBaseName(std::string_view filename)
+{
+	std::string name{filename.substr(filename.find_last_of("/\\") + 1)};
+	SanitizeFilename(name);
+	return name;
+}
+
 /**
  * Load a file into memory.
  * @param filename Name of the file to load.
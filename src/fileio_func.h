@@ -24,6 +24,7 @@ bool FioRemove(const std::string &filename);
 std::string_view FiosGetScreenshotDir();
 
 void SanitizeFilename(std::string &filename);
+std::string GetSanitizedFileBaseName(std::string_view filename);
 void AppendPathSeparator(std::string &buf);
 void DeterminePaths(std::string_view exe, bool only_local_path);
 std::unique_ptr<char[]> ReadFileToMem(const std::string &filename, size_t &lenp, size_t maxsize);
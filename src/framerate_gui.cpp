@@ -18,6 +18,7 @@
 #include "string_func.h"
 #include "strings_func.h"
 #include "console_func.h"
+#include "fileio_func.h"
 #include "console_type.h"
 #include "company_base.h"
 #include "ai/ai_info.hpp"
@@ -25,6 +26,7 @@
 #include "game/game.hpp"
 #include "game/game_instance.hpp"
 #include "timer/timer.h"
+#include "timer/timer_game_economy.h"
 #include "timer/timer_window.h"
 #include "zoom_func.h"
 
@@ -41,6 +43,25 @@ static std::mutex _sound_perf_lock;
 static std::atomic<bool> _sound_perf_pending;
 static std::vector<TimingMeasurement> _sound_perf_measurements;
 
+/** A single event in the performance trace. */
+struct PerformanceTraceEvent {
+	std::string_view name; ///< Name of a trace scope, or empty for a performance element.
+	PerformanceElement elem; ///< The performance element, when there is no name.
+	bool counter; ///< Whether this is an accumulated value instead of a block of time.
+	uint thread; ///< Number of the thread the event happened in.
+	TimingMeasurement start; ///< Start time of the event.
+	TimingMeasurement duration; ///< Duration of the event, or the accumulated value.
+};
+
+/** Maximum number of events to keep in a trace, to not run out of memory when tracing is forgotten. */
+static const size_t MAX_TRACE_EVENTS = 1000000;
+
+static std::atomic<bool> _perf_trace_active; ///< Whether a performance trace is being recorded.
+static std::mutex _perf_trace_lock; ///< Lock for the trace data, as events can come from any thread.
+static std::vector<PerformanceTraceEvent> _perf_trace_events; ///< Events recorded in the performance trace.
+static std::vector<std::pair<uint, std::string>> _perf_trace_thread_names; ///< Names of the threads in the trace.
+static std::atomic<uint> _perf_trace_thread_count; ///< Number of threads that got a trace thread number.
+
 /**
  * Private declarations for performance measurement implementation
  */
@@ -73,6 +94,16 @@ namespace {
 		/** Start time for current accumulation cycle */
 		TimingMeasurement acc_timestamp{};
 
+		/** Total time spent processing the element since the last #ResetPerformanceTotals */
+		TimingMeasurement total_duration = 0;
+		/** Number of cycles of the element since the last #ResetPerformanceTotals */
+		uint64_t total_cycles = 0;
+
+		/** Longest cycle of the element in the current economy month */
+		TimingMeasurement peak_duration = 0;
+		/** Longest cycle of the element in the previous economy month */
+		TimingMeasurement last_peak_duration = 0;
+
 		/**
 		 * Initialize a data element with an expected collection rate
 		 * @param expected_rate
@@ -84,6 +115,10 @@ namespace {
 		/** Collect a complete measurement, given start and ending times for a processing block */
 		void Add(TimingMeasurement start_time, TimingMeasurement end_time)
 		{
+			this->total_duration += end_time - start_time;
+			this->total_cycles++;
+			this->peak_duration = std::max(this->peak_duration, end_time - start_time);
+
 			this->durations[this->next_index] = end_time - start_time;
 			this->timestamps[this->next_index] = start_time;
 			this->prev_index = this->next_index;
@@ -95,6 +130,9 @@ namespace {
 		/** Begin an accumulation of multiple measurements into a single value, from a given start time */
 		void BeginAccumulate(TimingMeasurement start_time)
 		{
+			this->total_cycles++;
+			this->peak_duration = std::max(this->peak_duration, this->acc_duration);
+
 			this->timestamps[this->next_index] = this->acc_timestamp;
 			this->durations[this->next_index] = this->acc_duration;
 			this->prev_index = this->next_index;
@@ -109,6 +147,7 @@ namespace {
 		/** Accumulate a period onto the current measurement */
 		void AddAccumulate(TimingMeasurement duration)
 		{
+			this->total_duration += duration;
 			this->acc_duration += duration;
 		}
 
@@ -201,6 +240,13 @@ namespace {
 		PerformanceData(1),                     // PFE_ACC_GL_SHIPS
 		PerformanceData(1),                     // PFE_ACC_GL_AIRCRAFT
 		PerformanceData(1),                     // PFE_GL_LANDSCAPE
+		PerformanceData(1),                     // PFE_GL_TILELOOP
+		PerformanceData(1),                     // PFE_GL_ANIMATION
+		PerformanceData(1),                     // PFE_GL_TOWNS
+		PerformanceData(1),                     // PFE_GL_STATIONS
+		PerformanceData(1),                     // PFE_GL_INDUSTRIES
+		PerformanceData(1),                     // PFE_GL_TIMERS
+		PerformanceData(1),                     // PFE_GL_DAYPROCS
 		PerformanceData(1),                     // PFE_GL_LINKGRAPH
 		PerformanceData(1000.0 / 30),           // PFE_DRAWING
 		PerformanceData(1),                     // PFE_ACC_DRAWWORLD
@@ -225,6 +271,31 @@ namespace {
 		PerformanceData(1),                     // PFE_AI14
 	};
 
+	/** Names of the performance elements for console and other text output. */
+	const std::array<std::string_view, PFE_MAX> MEASUREMENT_NAMES = {
+		"Game loop",
+		"  GL station ticks",
+		"  GL train ticks",
+		"  GL road vehicle ticks",
+		"  GL ship ticks",
+		"  GL aircraft ticks",
+		"  GL landscape ticks",
+		"    GL tile loop",
+		"    GL tile animation",
+		"    GL town ticks",
+		"    GL station tick loop",
+		"    GL industry ticks",
+		"  GL timers",
+		"  GL vehicle day procs",
+		"  GL link graph delays",
+		"Drawing",
+		"  Viewport drawing",
+		"Video output",
+		"Sound mixing",
+		"AI/GS scripts total",
+		"Game script",
+	};
+
 }
 
 
@@ -240,6 +311,29 @@ static TimingMeasurement GetPerformanceTimer()
 }
 
 
+/**
+ * Get the number of the current thread in the performance trace.
+ * @return The thread number.
+ */
+static uint GetPerformanceTraceThread()
+{
+	thread_local uint thread = ++_perf_trace_thread_count;
+	return thread;
+}
+
+/**
+ * Record an event in the performance trace, if one is being recorded.
+ * @param event The event to record, its thread is filled in.
+ */
+static void AddPerformanceTraceEvent(PerformanceTraceEvent event)
+{
+	if (!_perf_trace_active.load(std::memory_order_relaxed)) return;
+
+	event.thread = GetPerformanceTraceThread();
+	std::lock_guard lk(_perf_trace_lock);
+	if (_perf_trace_events.size() < MAX_TRACE_EVENTS) _perf_trace_events.push_back(event);
+}
+
 /**
  * Begin a cycle of a measured element.
  * @param elem The element to be measured
@@ -278,7 +372,9 @@ PerformanceMeasurer::~PerformanceMeasurer()
 		_sound_perf_pending.store(true, std::memory_order_release);
 		return;
 	}
-	_pf_data[this->elem].Add(this->start_time, GetPerformanceTimer());
+	TimingMeasurement end = GetPerformanceTimer();
+	_pf_data[this->elem].Add(this->start_time, end);
+	AddPerformanceTraceEvent({{}, this->elem, false, 0, this->start_time, end - this->start_time});
 }
 
 /** Set the rate of expected cycles per second of a performance element. */
@@ -331,10 +427,40 @@ PerformanceAccumulator::~PerformanceAccumulator()
  */
 void PerformanceAccumulator::Reset(PerformanceElement elem)
 {
+	const PerformanceData &pf = _pf_data[elem];
+	if (pf.acc_timestamp != 0) AddPerformanceTraceEvent({{}, elem, true, 0, pf.acc_timestamp, pf.acc_duration});
+
 	_pf_data[elem].BeginAccumulate(GetPerformanceTimer());
 }
 
 
+/**
+ * Begin a block in the performance trace.
+ * @param name Name of the block, it must outlive the trace.
+ * @param thread_name Name of the thread the block runs in, if it is not the main thread.
+ */
+PerformanceTraceScope::PerformanceTraceScope(std::string_view name, std::string_view thread_name) : name(name)
+{
+	if (!_perf_trace_active.load(std::memory_order_relaxed)) return;
+
+	this->start_time = GetPerformanceTimer();
+	if (!thread_name.empty()) {
+		uint thread = GetPerformanceTraceThread();
+		std::lock_guard lk(_perf_trace_lock);
+		if (std::ranges::find(_perf_trace_thread_names, thread, &std::pair<uint, std::string>::first) == _perf_trace_thread_names.end()) {
+			_perf_trace_thread_names.emplace_back(thread, thread_name);
+		}
+	}
+}
+
+/** Finish the block and record it in the performance trace. */
+PerformanceTraceScope::~PerformanceTraceScope()
+{
+	if (this->start_time == 0) return;
+	AddPerformanceTraceEvent({this->name, PFE_MAX, false, 0, this->start_time, GetPerformanceTimer() - this->start_time});
+}
+
+
 void ShowFrametimeGraphWindow(PerformanceElement elem);
 
 
@@ -346,6 +472,13 @@ static const PerformanceElement DISPLAY_ORDER_PFE[PFE_MAX] = {
 	PFE_GL_SHIPS,
 	PFE_GL_AIRCRAFT,
 	PFE_GL_LANDSCAPE,
+	PFE_GL_TILELOOP,
+	PFE_GL_ANIMATION,
+	PFE_GL_TOWNS,
+	PFE_GL_STATIONS,
+	PFE_GL_INDUSTRIES,
+	PFE_GL_TIMERS,
+	PFE_GL_DAYPROCS,
 	PFE_ALLSCRIPTS,
 	PFE_GAMESCRIPT,
 	PFE_AI0,
@@ -1004,22 +1137,6 @@ void ConPrintFramerate()
 
 	IConsolePrint(TC_SILVER, "Based on num. data points: {} {} {}", count1, count2, count3);
 
-	static const std::array<std::string_view, PFE_MAX> MEASUREMENT_NAMES = {
-		"Game loop",
-		"  GL station ticks",
-		"  GL train ticks",
-		"  GL road vehicle ticks",
-		"  GL ship ticks",
-		"  GL aircraft ticks",
-		"  GL landscape ticks",
-		"  GL link graph delays",
-		"Drawing",
-		"  Viewport drawing",
-		"Video output",
-		"Sound mixing",
-		"AI/GS scripts total",
-		"Game script",
-	};
 	std::string ai_name_buf;
 
 	bool printed_anything = false;
@@ -1034,6 +1151,10 @@ void ConPrintFramerate()
 		printed_anything = true;
 	}
 
+	if (_pf_data[PFE_GAMELOOP].num_valid > 0) {
+		IConsolePrint(TC_GREEN, "Longest game loop tick in the previous month: {:.2f}ms", GetPerformancePeakDuration(PFE_GAMELOOP));
+	}
+
 	for (PerformanceElement e = PFE_FIRST; e < PFE_MAX; e++) {
 		auto &pf = _pf_data[e];
 		if (pf.num_valid == 0) continue;
@@ -1075,3 +1196,150 @@ void ProcessPendingPerformanceMeasurements()
 		_sound_perf_pending.store(false, std::memory_order_relaxed);
 	}
 }
+
+/**
+ * Get the average duration of the most recent measurements of a performance element.
+ * @param elem The element to get the duration of.
+ * @param count The number of measurements to average over.
+ * @return The average duration in milliseconds.
+ */
+double GetPerformanceAverageDuration(PerformanceElement elem, int count)
+{
+	return _pf_data[elem].GetAverageDurationMilliseconds(count);
+}
+
+/**
+ * Get the rate at which a performance element was measured in about the last second.
+ * @param elem The element to get the rate of.
+ * @return The rate in measurements per second.
+ */
+double GetPerformanceRate(PerformanceElement elem)
+{
+	return _pf_data[elem].GetRate();
+}
+
+/**
+ * Get the duration of the longest measurement of a performance element in the previous economy month.
+ * @param elem The element to get the duration of.
+ * @return The duration in milliseconds.
+ */
+double GetPerformancePeakDuration(PerformanceElement elem)
+{
+	return _pf_data[elem].last_peak_duration * 1000.0 / TIMESTAMP_PRECISION;
+}
+
+/** Start looking for the longest measurements of a new economy month. */
+static const IntervalTimer<TimerGameEconomy> _performance_peaks_monthly({TimerGameEconomy::MONTH, TimerGameEconomy::Priority::NONE}, [](auto)
+{
+	for (PerformanceData &pf : _pf_data) {
+		pf.last_peak_duration = pf.peak_duration;
+		pf.peak_duration = 0;
+	}
+});
+
+/** Reset the total time and cycles recorded for all performance elements. */
+void ResetPerformanceTotals()
+{
+	for (PerformanceData &pf : _pf_data) {
+		pf.total_duration = 0;
+		pf.total_cycles = 0;
+	}
+}
+
+/**
+ * Print the total time spent in each performance element since the last #ResetPerformanceTotals to the standard output.
+ * @param ticks Number of game ticks run since the reset, to calculate the time spent per tick.
+ */
+void PrintPerformanceTotals(uint64_t ticks)
+{
+	if (ticks == 0) return;
+
+	for (PerformanceElement e = PFE_FIRST; e < PFE_MAX; e++) {
+		const PerformanceData &pf = _pf_data[e];
+		if (pf.total_cycles == 0) continue;
+
+		std::string name = e < PFE_AI0 ? std::string(MEASUREMENT_NAMES[e]) : fmt::format("AI {} {}", e - PFE_AI0 + 1, GetAIName(e - PFE_AI0));
+		double total_ms = (double)pf.total_duration * 1000 / TIMESTAMP_PRECISION;
+		fmt::print("{:<26} {:12.2f}ms total  {:9.4f}ms/tick\n", name, total_ms, total_ms / ticks);
+	}
+}
+
+/**
+ * Start recording a performance trace, discarding any trace that was being recorded.
+ */
+void StartPerformanceTrace()
+{
+	std::lock_guard lk(_perf_trace_lock);
+	_perf_trace_events.clear();
+	_perf_trace_thread_names.clear();
+	_perf_trace_active.store(true);
+}
+
+/**
+ * Check whether a performance trace is being recorded.
+ * @return True iff a trace is being recorded.
+ */
+bool IsPerformanceTraceActive()
+{
+	return _perf_trace_active.load();
+}
+
+/**
+ * Stop recording the performance trace and write it to a file in the Chrome trace event format,
+ * which can be viewed with about://tracing in Chrome or with Perfetto.
+ * The file is always written into the save directory.
+ * @param[in,out] filename The name of the file to write the trace to; any path is stripped from it.
+ * @return The number of events written, or \c std::nullopt if the file could not be written.
+ */
+std::optional<size_t> StopPerformanceTrace(std::string &filename)
+{
+	_perf_trace_active.store(false);
+
+	filename = GetSanitizedFileBaseName(filename);
+	if (filename.empty()) return std::nullopt;
+
+	std::lock_guard lk(_perf_trace_lock);
+	auto f = FioFOpenFile(filename, "w", SAVE_DIR);
+	if (!f.has_value()) return std::nullopt;
+
+	auto escape = [](std::string_view str) {
+		std::string result;
+		for (char c : str) {
+			if (c == '"' || c == '\\') result += '\\';
+			if (static_cast<uint8_t>(c) >= ' ') result += c;
+		}
+		return result;
+	};
+
+	fmt::print(*f, "{{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	bool first = true;
+	for (const auto &[thread, name] : _perf_trace_thread_names) {
+		fmt::print(*f, "{}{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"{}\"}}}}", first ? "" : ",\n", thread, escape(name));
+		first = false;
+	}
+	for (const PerformanceTraceEvent &event : _perf_trace_events) {
+		std::string name;
+		if (!event.name.empty()) {
+			name = event.name;
+		} else if (event.elem < PFE_AI0) {
+			name = StrTrimView(MEASUREMENT_NAMES[event.elem], " ");
+		} else {
+			name = fmt::format("AI {} {}", event.elem - PFE_AI0 + 1, GetAIName(event.elem - PFE_AI0));
+		}
+
+		if (event.counter) {
+			fmt::print(*f, "{}{{\"name\":\"{}\",\"ph\":\"C\",\"pid\":1,\"tid\":{},\"ts\":{},\"args\":{{\"ms\":{:.3f}}}}}",
+				first ? "" : ",\n", escape(name), event.thread, event.start, (double)event.duration * 1000 / TIMESTAMP_PRECISION);
+		} else {
+			fmt::print(*f, "{}{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{},\"dur\":{}}}",
+				first ? "" : ",\n", escape(name), event.thread, event.start, event.duration);
+		}
+		first = false;
+	}
+	fmt::print(*f, "\n]}}\n");
+
+	size_t count = _perf_trace_events.size();
+	_perf_trace_events.clear();
+	_perf_trace_events.shrink_to_fit();
+	return count;
+}
@@ -18,7 +18,7 @@
  * Second is adding a member to the \link anonymous_namespace{framerate_gui.cpp}::_pf_data _pf_data \endlink array, in the same position as the new #PerformanceElement member.
  *
  * @par
- * Third is adding strings for the new element. There is an array in #ConPrintFramerate with strings used for the console command.
+ * Third is adding strings for the new element. There is an array \c MEASUREMENT_NAMES in framerate_gui.cpp with strings used for the console command.
  * Additionally, there are two sets of strings in \c english.txt for two GUI uses, also in the #PerformanceElement order.
  * Search for \c STR_FRAMERATE_GAMELOOP and \c STR_FRAMETIME_CAPTION_GAMELOOP in \c english.txt to find those.
  *
@@ -52,6 +52,13 @@ enum PerformanceElement : uint8_t {
 	PFE_GL_SHIPS,      ///< Time spent processing ships
 	PFE_GL_AIRCRAFT,   ///< Time spent processing aircraft
 	PFE_GL_LANDSCAPE,  ///< Time spent processing other world features
+	PFE_GL_TILELOOP,   ///< Time spent in the tile loop
+	PFE_GL_ANIMATION,  ///< Time spent animating tiles
+	PFE_GL_TOWNS,      ///< Time spent processing towns
+	PFE_GL_STATIONS,   ///< Time spent processing stations
+	PFE_GL_INDUSTRIES, ///< Time spent processing industries
+	PFE_GL_TIMERS,     ///< Time spent running calendar, economy and tick timers
+	PFE_GL_DAYPROCS,   ///< Time spent in the daily processing of vehicles
 	PFE_GL_LINKGRAPH,  ///< Time spent waiting for link graph background jobs
 	PFE_DRAWING,       ///< Speed of drawing world and GUI.
 	PFE_DRAWWORLD,     ///< Time spent drawing world viewports in GUI
@@ -119,7 +126,28 @@ public:
 	static void Reset(PerformanceElement elem);
 };
 
+/**
+ * RAII class for marking a block of processing in the performance trace, see #StartPerformanceTrace.
+ * Unlike the other classes it does not keep any statistics and can be used from any thread.
+ */
+class PerformanceTraceScope {
+	std::string_view name;
+	TimingMeasurement start_time = 0;
+public:
+	PerformanceTraceScope(std::string_view name, std::string_view thread_name = {});
+	~PerformanceTraceScope();
+};
+
+void StartPerformanceTrace();
+bool IsPerformanceTraceActive();
+std::optional<size_t> StopPerformanceTrace(std::string &filename);
+
 void ShowFramerateWindow();
 void ProcessPendingPerformanceMeasurements();
+double GetPerformanceAverageDuration(PerformanceElement elem, int count);
+double GetPerformanceRate(PerformanceElement elem);
+double GetPerformancePeakDuration(PerformanceElement elem);
+void ResetPerformanceTotals();
+void PrintPerformanceTotals(uint64_t ticks);
 
 #endif /* FRAMERATE_TYPE_H */
@@ -88,6 +88,9 @@ void GroundVehicle<T, Type>::CargoChanged()
 		u->gcache.cached_slope_resistance = current_weight * u->GetSlopeSteepness() * 100;
 	}
 
+	/* The slope resistance of the parts might have changed. */
+	this->InvalidateSlopeResistance();
+
 	/* Store consist weight in cache. */
 	this->gcache.cached_weight = std::max(1u, weight);
 	/* Friction in bearings and other mechanical parts is 0.1% of the weight (result in N). */
@@ -98,11 +101,48 @@ void GroundVehicle<T, Type>::CargoChanged()
 }
 
 /**
- * Calculates the acceleration of the vehicle under its current conditions.
+ * Gets the acceleration of the vehicle under its current conditions.
+ * The previous result is reused when none of the inputs of the calculation changed.
  * @return Current acceleration of the vehicle.
  */
 template <class T, VehicleType Type>
 int GroundVehicle<T, Type>::GetAcceleration() const
+{
+	/* Templated class used for function calls for performance reasons. */
+	const T *v = T::From(this);
+
+	/* Vehicles running at a stable speed on the same kind of track keep all inputs
+	 * of the calculation the same, so reuse the result of the previous calculation. */
+	GroundVehicleAccelerationCache &ac = this->acache;
+	const uint16_t cur_speed = v->GetCurrentSpeed();
+	const AccelStatus cur_mode = v->GetAccelerationStatus();
+	const uint8_t cur_area = v->GetAirDragArea();
+	const uint32_t cur_rolling_friction = v->GetRollingFriction();
+	const int cur_acceleration_type = v->GetAccelerationType();
+	const int64_t cur_slope = this->GetSlopeResistance();
+	if (ac.valid && ac.speed == cur_speed && ac.mode == cur_mode && ac.area == cur_area && ac.rolling_friction == cur_rolling_friction &&
+			ac.acceleration_type == cur_acceleration_type && ac.slope == cur_slope && ac.gcache == this->gcache) {
+		return ac.acceleration;
+	}
+
+	ac.valid = true;
+	ac.speed = cur_speed;
+	ac.mode = cur_mode;
+	ac.area = cur_area;
+	ac.rolling_friction = cur_rolling_friction;
+	ac.acceleration_type = cur_acceleration_type;
+	ac.slope = cur_slope;
+	ac.gcache = this->gcache;
+	ac.acceleration = this->CalcAcceleration();
+	return ac.acceleration;
+}
+
+/**
+ * Calculates the acceleration of the vehicle under its current circumstances.
+ * @return Current acceleration of the vehicle.
+ */
+template <class T, VehicleType Type>
+int GroundVehicle<T, Type>::CalcAcceleration() const
 {
 	/* Templated class used for function calls for performance reasons. */
 	const T *v = T::From(this);
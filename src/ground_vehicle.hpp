@@ -50,6 +50,26 @@ struct GroundVehicleCache {
 	auto operator<=>(const GroundVehicleCache &) const = default;
 };
 
+/**
+ * Inputs and result of the last acceleration calculation, only valid for the first part of a vehicle.
+ * This is not part of #GroundVehicleCache as it is not (re)calculated together with the other caches;
+ * the acceleration is only recomputed when any of its inputs changed.
+ */
+struct GroundVehicleAccelerationCache {
+	int64_t slope_resistance = 0; ///< Total slope resistance of the consist.
+	bool slope_resistance_valid = false; ///< Whether #slope_resistance is up to date with the inclination of all parts.
+
+	bool valid = false; ///< Whether the inputs below have been filled by an earlier calculation.
+	uint16_t speed = 0; ///< Speed the acceleration was calculated for.
+	AccelStatus mode = AS_ACCEL; ///< Acceleration status the acceleration was calculated for.
+	uint8_t area = 0; ///< Air drag area the acceleration was calculated for.
+	uint32_t rolling_friction = 0; ///< Rolling friction the acceleration was calculated for.
+	int acceleration_type = 0; ///< Acceleration type the acceleration was calculated for.
+	int64_t slope = 0; ///< Slope resistance the acceleration was calculated for.
+	GroundVehicleCache gcache{}; ///< Cached consist properties the acceleration was calculated for.
+	int acceleration = 0; ///< The calculated acceleration.
+};
+
 /** Ground vehicle flags. */
 enum GroundVehicleFlags : uint8_t {
 	GVF_GOINGUP_BIT              = 0,  ///< Vehicle is currently going uphill. (Cached track information for acceleration)
@@ -81,6 +101,7 @@ enum GroundVehicleFlags : uint8_t {
 template <class T, VehicleType Type>
 struct GroundVehicle : public SpecializedVehicle<T, Type> {
 	GroundVehicleCache gcache{}; ///< Cache of often calculated values.
+	mutable GroundVehicleAccelerationCache acache{}; ///< NOSAVE: Cache of the last acceleration calculation.
 	uint16_t gv_flags = 0; ///< @see GroundVehicleFlags.
 
 	typedef GroundVehicle<T, Type> GroundVehicleBase; ///< Our type
@@ -93,6 +114,7 @@ struct GroundVehicle : public SpecializedVehicle<T, Type> {
 	void PowerChanged();
 	void CargoChanged();
 	int GetAcceleration() const;
+	int CalcAcceleration() const;
 	bool IsChainInDepot() const override;
 
 	/**
@@ -107,14 +129,38 @@ struct GroundVehicle : public SpecializedVehicle<T, Type> {
 			ClrBit(v->gv_flags, GVF_GOINGUP_BIT);
 			ClrBit(v->gv_flags, GVF_GOINGDOWN_BIT);
 		}
+		this->InvalidateSlopeResistance();
 		return this->Vehicle::Crash(flooded);
 	}
 
 	/**
-	 * Calculates the total slope resistance for this vehicle.
+	 * Mark the total slope resistance of the consist as outdated.
+	 * Must be called whenever the inclination or slope resistance of any of its parts changes.
+	 */
+	inline void InvalidateSlopeResistance()
+	{
+		this->First()->acache.slope_resistance_valid = false;
+	}
+
+	/**
+	 * Gets the total slope resistance for this vehicle.
+	 * It is only recalculated when the inclination of a part changed since the last call.
 	 * @return Slope resistance.
 	 */
 	inline int64_t GetSlopeResistance() const
+	{
+		if (!this->acache.slope_resistance_valid) {
+			this->acache.slope_resistance = this->CalcSlopeResistance();
+			this->acache.slope_resistance_valid = true;
+		}
+		return this->acache.slope_resistance;
+	}
+
+	/**
+	 * Calculates the total slope resistance for this vehicle.
+	 * @return Slope resistance.
+	 */
+	inline int64_t CalcSlopeResistance() const
 	{
 		int64_t incl = 0;
 
@@ -137,6 +183,7 @@ struct GroundVehicle : public SpecializedVehicle<T, Type> {
 	 */
 	inline void UpdateZPositionAndInclination()
 	{
+		uint16_t old_flags = this->gv_flags;
 		this->z_pos = GetSlopePixelZ(this->x_pos, this->y_pos, true);
 		ClrBit(this->gv_flags, GVF_GOINGUP_BIT);
 		ClrBit(this->gv_flags, GVF_GOINGDOWN_BIT);
@@ -152,6 +199,8 @@ struct GroundVehicle : public SpecializedVehicle<T, Type> {
 				SetBit(this->gv_flags, (middle_z > this->z_pos) ? GVF_GOINGUP_BIT : GVF_GOINGDOWN_BIT);
 			}
 		}
+
+		if (this->gv_flags != old_flags) this->InvalidateSlopeResistance();
 	}
 
 	/**
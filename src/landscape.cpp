@@ -762,6 +762,8 @@ TileIndex _cur_tileloop_tile;
 void RunTileLoop()
 {
 	PerformanceAccumulator framerate(PFE_GL_LANDSCAPE);
+	PerformanceMeasurer tile_loop_framerate(PFE_GL_TILELOOP);
+	PerformanceTraceScope trace("Tile loop");
 
 	/* The pseudorandom sequence of tiles is generated using a Galois linear feedback
 	 * shift register (LFSR). This allows a deterministic pseudorandom ordering, but
@@ -1647,10 +1649,19 @@ void CallLandscapeTick()
 	{
 		PerformanceAccumulator framerate(PFE_GL_LANDSCAPE);
 
-		OnTick_Town();
+		{
+			PerformanceMeasurer towns_framerate(PFE_GL_TOWNS);
+			OnTick_Town();
+		}
 		OnTick_Trees();
-		OnTick_Station();
-		OnTick_Industry();
+		{
+			PerformanceMeasurer stations_framerate(PFE_GL_STATIONS);
+			OnTick_Station();
+		}
+		{
+			PerformanceMeasurer industries_framerate(PFE_GL_INDUSTRIES);
+			OnTick_Industry();
+		}
 	}
 
 	OnTick_Companies();
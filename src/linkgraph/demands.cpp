@@ -3,11 +3,106 @@
 #include "../stdafx.h"
 #include "demands.h"
 #include "../core/math_func.hpp"
-#include <queue>
+#include <mutex>
 
 #include "../safeguards.h"
 
-typedef std::queue<NodeID> NodeList;
+/** Number of node pairs up to which the divisors of all pairs are calculated in advance. */
+static constexpr uint64_t MAX_PRECALCULATED_DIVISORS = 1 << 22;
+
+/**
+ * Demands of a link graph, together with everything they were calculated from.
+ * As the calculation only depends on that input, the demands can be reused
+ * for the next job of the link graph if its input is the same.
+ */
+struct DemandCacheEntry {
+	/** The input of the calculation for a single node. */
+	struct NodeInput {
+		uint supply; ///< Supply the demands are calculated with.
+		uint demand; ///< Acceptance at the node.
+		TileIndex xy; ///< Location of the node.
+
+		bool operator==(const NodeInput &) const = default;
+	};
+
+	std::array<int32_t, 5> parameters{}; ///< Distribution type, settings and map dependent values used for the calculation.
+	std::vector<NodeInput> nodes{}; ///< Input per node.
+	std::vector<std::vector<std::pair<NodeID, uint>>> demands{}; ///< Non-zero demands per node.
+	std::vector<uint> undelivered_supply{}; ///< Supply that could not be distributed per node.
+
+	/**
+	 * Check whether the demands of this entry were calculated from the same input as the other one.
+	 * @param other Entry to compare with.
+	 * @return True iff both have the same input.
+	 */
+	bool HasSameInput(const DemandCacheEntry &other) const
+	{
+		return this->parameters == other.parameters && this->nodes == other.nodes;
+	}
+};
+
+static std::mutex _demand_cache_mutex; ///< Lock for the demand cache, as jobs run in multiple threads.
+static std::map<LinkGraphID, DemandCacheEntry> _demand_cache; ///< Demands of the last job of each link graph.
+
+/**
+ * Restore the demands of a job from the cache, if they have been calculated from the same input before.
+ * @param job The job to set the demands of.
+ * @param input The input of the job's demand calculation.
+ * @return True if the demands were restored.
+ */
+static bool RestoreCachedDemands(LinkGraphJob &job, const DemandCacheEntry &input)
+{
+	std::lock_guard<std::mutex> lock(_demand_cache_mutex);
+	auto it = _demand_cache.find(job.LinkGraphIndex());
+	if (it == _demand_cache.end() || !it->second.HasSameInput(input)) return false;
+
+	const DemandCacheEntry &entry = it->second;
+	for (NodeID node = 0; node < job.Size(); node++) {
+		for (const auto &[to, demand] : entry.demands[node]) {
+			job[node].demands[to].demand = demand;
+			job[node].demands[to].unsatisfied_demand = demand;
+		}
+		job[node].undelivered_supply = entry.undelivered_supply[node];
+	}
+	return true;
+}
+
+/**
+ * Store the calculated demands of a job in the cache.
+ * @param job The job to store the demands of.
+ * @param entry The input of the job's demand calculation.
+ */
+static void StoreCachedDemands(LinkGraphJob &job, DemandCacheEntry &&entry)
+{
+	entry.demands.resize(job.Size());
+	entry.undelivered_supply.resize(job.Size());
+	for (NodeID node = 0; node < job.Size(); node++) {
+		for (NodeID to = 0; to < job.Size(); to++) {
+			if (job[node].demands[to].demand > 0) entry.demands[node].emplace_back(to, job[node].demands[to].demand);
+		}
+		entry.undelivered_supply[node] = job[node].undelivered_supply;
+	}
+
+	std::lock_guard<std::mutex> lock(_demand_cache_mutex);
+	_demand_cache[job.LinkGraphIndex()] = std::move(entry);
+}
+
+/** Forget all cached demands, e.g. when a new game is loaded. */
+void ClearDemandCache()
+{
+	std::lock_guard<std::mutex> lock(_demand_cache_mutex);
+	_demand_cache.clear();
+}
+
+/**
+ * Forget the cached demands of a link graph, e.g. when it has been deleted or merged into another one.
+ * @param link_graph The link graph to forget the demands of.
+ */
+void ClearDemandCache(LinkGraphID link_graph)
+{
+	std::lock_guard<std::mutex> lock(_demand_cache_mutex);
+	_demand_cache.erase(link_graph);
+}
 
 /**
  * Scale various things according to symmetric/asymmetric distribution.
@@ -37,7 +132,7 @@ public:
 	 */
 	inline void AddNode(const Node &node)
 	{
-		this->supply_sum += node.base.supply;
+		this->supply_sum += node.base.demand_supply;
 	}
 
 	/**
@@ -58,7 +153,7 @@ public:
 	 */
 	inline uint EffectiveSupply(const Node &from, const Node &to)
 	{
-		return std::max(from.base.supply * std::max(1U, to.base.supply) * this->mod_size / 100 / this->demand_per_node, 1U);
+		return std::max(from.base.demand_supply * std::max(1U, to.base.demand_supply) * this->mod_size / 100 / this->demand_per_node, 1U);
 	}
 
 	/**
@@ -70,7 +165,7 @@ public:
 	 */
 	inline bool HasDemandLeft(const Node &to)
 	{
-		return (to.base.supply == 0 || to.undelivered_supply > 0) && to.base.demand > 0;
+		return (to.base.demand_supply == 0 || to.undelivered_supply > 0) && to.base.demand > 0;
 	}
 
 	void SetDemands(LinkGraphJob &job, NodeID from, NodeID to, uint demand_forw);
@@ -109,7 +204,7 @@ public:
 	 */
 	inline uint EffectiveSupply(const Node &from, const Node &)
 	{
-		return from.base.supply;
+		return from.base.demand_supply;
 	}
 
 	/**
@@ -156,6 +251,23 @@ inline void Scaler::SetDemands(LinkGraphJob &job, NodeID from_id, NodeID to_id,
 	job[from_id].DeliverSupply(to_id, demand_forw);
 }
 
+/**
+ * Get the divisor for the demand between two nodes, which scales the accuracy by their distance around accuracy / 2.
+ * @param distance The distance between the nodes.
+ * @return The divisor, scaled by #DIVISOR_SCALE.
+ */
+inline int32_t DemandCalculator::GetDivisor(int32_t distance) const
+{
+	int32_t scaled_distance = this->base_distance;
+	if (this->mod_dist > 0) {
+		/* Scale distance around base_distance by (mod_dist * (100 / 1024)).
+		 * mod_dist may be > 1024, so clamp result to be non-negative */
+		scaled_distance = std::max(0, this->base_distance + (((distance - this->base_distance) * this->mod_dist) / 1024));
+	}
+
+	return DIVISOR_SCALE + ((this->accuracy * scaled_distance * DIVISOR_SCALE) / (this->base_distance * 2));
+}
+
 /**
  * Do the actual demand calculation, called from constructor.
  * @param job Job to calculate the demands for.
@@ -164,18 +276,28 @@ inline void Scaler::SetDemands(LinkGraphJob &job, NodeID from_id, NodeID to_id,
 template <class Tscaler>
 void DemandCalculator::CalcDemand(LinkGraphJob &job, Tscaler scaler)
 {
-	NodeList supplies;
-	NodeList demands;
+	NodeQueue supplies(job.Size());
+	NodeQueue demands(job.Size());
 	uint num_supplies = 0;
 	uint num_demands = 0;
 
+	/* Position of each node among the supplying and among the accepting nodes, and the locations of the latter. */
+	std::vector<uint> supply_index(job.Size());
+	std::vector<uint> demand_index(job.Size());
+	std::vector<int32_t> demand_x;
+	std::vector<int32_t> demand_y;
+
 	for (NodeID node = 0; node < job.Size(); node++) {
 		scaler.AddNode(job[node]);
-		if (job[node].base.supply > 0) {
+		if (job[node].base.demand_supply > 0) {
+			supply_index[node] = num_supplies;
 			supplies.push(node);
 			num_supplies++;
 		}
 		if (job[node].base.demand > 0) {
+			demand_index[node] = num_demands;
+			demand_x.push_back(TileX(job[node].base.xy));
+			demand_y.push_back(TileY(job[node].base.xy));
 			demands.push(node);
 			num_demands++;
 		}
@@ -183,6 +305,28 @@ void DemandCalculator::CalcDemand(LinkGraphJob &job, Tscaler scaler)
 
 	if (num_supplies == 0 || num_demands == 0) return;
 
+	/* The iteration below may visit each pair of nodes many times before all
+	 * supply is distributed. As the divisor of a pair only depends on their
+	 * distance, calculate it once for all pairs, one row per supplying node. */
+	const uint row_size = num_demands;
+	std::vector<int32_t> divisors;
+	if (this->mod_dist > 0 && static_cast<uint64_t>(num_supplies) * num_demands <= MAX_PRECALCULATED_DIVISORS) {
+		divisors.resize(num_supplies * row_size);
+		for (NodeID node = 0; node < job.Size(); node++) {
+			if (job[node].base.demand_supply == 0) continue;
+
+			const int32_t x = TileX(job[node].base.xy);
+			const int32_t y = TileY(job[node].base.xy);
+			int32_t *row = divisors.data() + supply_index[node] * row_size;
+			for (uint i = 0; i < row_size; i++) {
+				/* Same as DistanceMaxPlusManhattan, but on the unpacked locations. */
+				const int32_t dx = std::abs(x - demand_x[i]);
+				const int32_t dy = std::abs(y - demand_y[i]);
+				row[i] = this->GetDivisor(dx > dy ? 2 * dx + dy : 2 * dy + dx);
+			}
+		}
+	}
+
 	/* Mean acceptance attributed to each node. If the distribution is
 	 * symmetric this is relative to remote supply, otherwise it is
 	 * relative to remote demand. */
@@ -192,6 +336,7 @@ void DemandCalculator::CalcDemand(LinkGraphJob &job, Tscaler scaler)
 	while (!supplies.empty() && !demands.empty()) {
 		NodeID from_id = supplies.front();
 		supplies.pop();
+		const int32_t *row = divisors.empty() ? nullptr : divisors.data() + supply_index[from_id] * row_size;
 
 		for (uint i = 0; i < num_demands; ++i) {
 			assert(!demands.empty());
@@ -208,26 +353,16 @@ void DemandCalculator::CalcDemand(LinkGraphJob &job, Tscaler scaler)
 			int32_t supply = scaler.EffectiveSupply(job[from_id], job[to_id]);
 			assert(supply > 0);
 
-			constexpr int32_t divisor_scale = 16;
-
-			int32_t scaled_distance = this->base_distance;
-			if (this->mod_dist > 0) {
-				const int32_t distance = DistanceMaxPlusManhattan(job[from_id].base.xy, job[to_id].base.xy);
-				/* Scale distance around base_distance by (mod_dist * (100 / 1024)).
-				 * mod_dist may be > 1024, so clamp result to be non-negative */
-				scaled_distance = std::max(0, this->base_distance + (((distance - this->base_distance) * this->mod_dist) / 1024));
-			}
-
-			/* Scale the accuracy by distance around accuracy / 2 */
-			const int32_t divisor = divisor_scale + ((this->accuracy * scaled_distance * divisor_scale) / (this->base_distance * 2));
-			assert(divisor >= divisor_scale);
+			const int32_t divisor = row != nullptr ? row[demand_index[to_id]] :
+					this->GetDivisor(this->mod_dist > 0 ? DistanceMaxPlusManhattan(job[from_id].base.xy, job[to_id].base.xy) : 0);
+			assert(divisor >= DIVISOR_SCALE);
 
 			uint demand_forw = 0;
-			if (divisor <= (supply * divisor_scale)) {
+			if (divisor <= (supply * DIVISOR_SCALE)) {
 				/* At first only distribute demand if
 				 * effective supply / accuracy divisor >= 1
 				 * Others are too small or too far away to be considered. */
-				demand_forw = (supply * divisor_scale) / divisor;
+				demand_forw = (supply * DIVISOR_SCALE) / divisor;
 			} else if (++chance > this->accuracy * num_demands * num_supplies) {
 				/* After some trying, if there is still supply left, distribute
 				 * demand also to other nodes. */
@@ -279,15 +414,23 @@ DemandCalculator::DemandCalculator(LinkGraphJob &job) :
 		this->mod_dist = 100 + ((over100 * over100) / 12);
 	}
 
-	switch (settings.GetDistributionType(cargo)) {
-		case DT_SYMMETRIC:
-			this->CalcDemand<SymmetricScaler>(job, SymmetricScaler(settings.demand_size));
-			break;
-		case DT_ASYMMETRIC:
-			this->CalcDemand<AsymmetricScaler>(job, AsymmetricScaler());
-			break;
-		default:
-			/* Nothing to do. */
-			break;
+	DistributionType type = settings.GetDistributionType(cargo);
+	if (type != DT_SYMMETRIC && type != DT_ASYMMETRIC) return;
+
+	/* Demands of stable networks rarely change; reuse them if nothing they depend on did. */
+	DemandCacheEntry input;
+	input.parameters = {type, this->accuracy, this->mod_dist, settings.demand_size, this->base_distance};
+	input.nodes.reserve(job.Size());
+	for (NodeID node = 0; node < job.Size(); node++) {
+		input.nodes.emplace_back(job[node].base.demand_supply, job[node].base.demand, job[node].base.xy);
 	}
+	if (RestoreCachedDemands(job, input)) return;
+
+	if (type == DT_SYMMETRIC) {
+		this->CalcDemand<SymmetricScaler>(job, SymmetricScaler(settings.demand_size));
+	} else {
+		this->CalcDemand<AsymmetricScaler>(job, AsymmetricScaler());
+	}
+
+	StoreCachedDemands(job, std::move(input));
 }
@@ -5,6 +5,40 @@
 
 #include "linkgraphjob_base.h"
 
+/**
+ * Queue of nodes in which each node is at most once. As its size is
+ * limited by the number of nodes, it is kept in a single ring buffer.
+ */
+class NodeQueue {
+public:
+	/**
+	 * Create an empty queue.
+	 * @param capacity Number of nodes in the link graph.
+	 */
+	NodeQueue(uint capacity) : nodes(capacity) {}
+
+	inline bool empty() const { return this->count == 0; }
+	inline NodeID front() const { return this->nodes[this->first]; }
+
+	inline void pop()
+	{
+		if (++this->first == this->nodes.size()) this->first = 0;
+		this->count--;
+	}
+
+	inline void push(NodeID node)
+	{
+		assert(this->count < this->nodes.size());
+		size_t last = this->first + this->count++;
+		this->nodes[last < this->nodes.size() ? last : last - this->nodes.size()] = node;
+	}
+
+private:
+	std::vector<NodeID> nodes; ///< Ring buffer of the queued nodes.
+	size_t first = 0; ///< Position of the first node in the buffer.
+	size_t count = 0; ///< Number of queued nodes.
+};
+
 /**
  * Calculate the demands. This class has a state, but is recreated for each
  * call to of DemandHandler::Run.
@@ -14,10 +48,14 @@ public:
 	DemandCalculator(LinkGraphJob &job);
 
 private:
+	static constexpr int32_t DIVISOR_SCALE = 16; ///< Fixed point scale of the divisors of the demands.
+
 	int32_t base_distance; ///< Base distance for scaling purposes.
 	int32_t mod_dist;      ///< Distance modifier, determines how much demands decrease with distance.
 	int32_t accuracy;      ///< Accuracy of the calculation.
 
+	int32_t GetDivisor(int32_t distance) const;
+
 	template <class Tscaler>
 	void CalcDemand(LinkGraphJob &job, Tscaler scaler);
 };
@@ -40,4 +78,7 @@ public:
 	virtual ~DemandHandler() = default;
 };
 
+void ClearDemandCache();
+void ClearDemandCache(LinkGraphID link_graph);
+
 #endif /* DEMANDS_H */
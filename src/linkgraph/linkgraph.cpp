@@ -10,6 +10,7 @@
 #include "../stdafx.h"
 #include "../core/pool_func.hpp"
 #include "linkgraph.h"
+#include "demands.h"
 
 #include "../safeguards.h"
 
@@ -27,6 +28,7 @@ LinkGraph::BaseNode::BaseNode(TileIndex xy, StationID st, uint demand)
 {
 	this->xy = xy;
 	this->supply = 0;
+	this->demand_supply = 0;
 	this->demand = demand;
 	this->station = st;
 	this->last_update = EconomyTime::INVALID_DATE;
@@ -56,7 +58,7 @@ void LinkGraph::ShiftDates(TimerGameEconomy::Date interval)
 	for (NodeID node1 = 0; node1 < this->Size(); ++node1) {
 		BaseNode &source = this->nodes[node1];
 		if (source.last_update != EconomyTime::INVALID_DATE) source.last_update += interval;
-		for (BaseEdge &edge : this->nodes[node1].edges) {
+		for (BaseEdge &edge : this->nodes[node1].GetMutableEdges()) {
 			if (edge.last_unrestricted_update != EconomyTime::INVALID_DATE) edge.last_unrestricted_update += interval;
 			if (edge.last_restricted_update != EconomyTime::INVALID_DATE) edge.last_restricted_update += interval;
 		}
@@ -68,7 +70,8 @@ void LinkGraph::Compress()
 	this->last_compression = TimerGameEconomy::Date{(TimerGameEconomy::date + this->last_compression).base() / 2};
 	for (NodeID node1 = 0; node1 < this->Size(); ++node1) {
 		this->nodes[node1].supply /= 2;
-		for (BaseEdge &edge : this->nodes[node1].edges) {
+		this->nodes[node1].demand_supply /= 2;
+		for (BaseEdge &edge : this->nodes[node1].GetMutableEdges()) {
 			if (edge.capacity > 0) {
 				uint new_capacity = std::max(1U, edge.capacity / 2);
 				if (edge.capacity < (1 << 16)) {
@@ -83,6 +86,30 @@ void LinkGraph::Compress()
 	}
 }
 
+/**
+ * Let the supplies used for calculating demands follow the actual supplies,
+ * if those have changed by more than 1 / #DEMAND_SUPPLY_TOLERANCE. Small
+ * changes are ignored, so the demands of a stable network do not need to be
+ * recalculated for every job.
+ */
+void LinkGraph::UpdateDemandSupplies()
+{
+	for (BaseNode &node : this->nodes) {
+		uint tolerance = node.demand_supply / DEMAND_SUPPLY_TOLERANCE;
+		if (node.supply > node.demand_supply + tolerance || node.supply + tolerance < node.demand_supply) node.demand_supply = node.supply;
+	}
+}
+
+/**
+ * Clean up a link graph, also when it has been merged into another one.
+ */
+LinkGraph::~LinkGraph()
+{
+	if (CleaningPool()) return;
+
+	ClearDemandCache(this->index);
+}
+
 /**
  * Merge a link graph with another one.
  * @param other LinkGraph to be merged into this one.
@@ -96,11 +123,12 @@ void LinkGraph::Merge(LinkGraph *other)
 		Station *st = Station::Get(other->nodes[node1].station);
 		NodeID new_node = this->AddNode(st);
 		this->nodes[new_node].supply = LinkGraph::Scale(other->nodes[node1].supply, age, other_age);
+		this->nodes[new_node].demand_supply = LinkGraph::Scale(other->nodes[node1].demand_supply, age, other_age);
 		st->goods[this->cargo].link_graph = this->index;
 		st->goods[this->cargo].node = new_node;
 
-		for (BaseEdge &e : other->nodes[node1].edges) {
-			BaseEdge &new_edge = this->nodes[new_node].edges.emplace_back(first + e.dest_node);
+		for (const BaseEdge &e : other->nodes[node1].GetEdges()) {
+			BaseEdge &new_edge = this->nodes[new_node].GetMutableEdges().emplace_back(first + e.dest_node);
 			new_edge.capacity = LinkGraph::Scale(e.capacity, age, other_age);
 			new_edge.usage = LinkGraph::Scale(e.usage, age, other_age);
 			new_edge.travel_time_sum = LinkGraph::Scale(e.travel_time_sum, age, other_age);
@@ -124,16 +152,20 @@ void LinkGraph::RemoveNode(NodeID id)
 	this->nodes[id] = this->nodes.back();
 	this->nodes.pop_back();
 	for (auto &n : this->nodes) {
+		/* Leave the edges alone if they do not change, so they are not copied while shared with a job. */
+		if (!n.HasEdgeTo(id) && (n.GetEdges().empty() || n.GetEdges().back().dest_node != last_node)) continue;
+
+		std::vector<BaseEdge> &edges = n.GetMutableEdges();
 		/* Find iterator position where an edge to id would be. */
-		auto [first, last] = std::equal_range(n.edges.begin(), n.edges.end(), id);
+		auto [first, last] = std::equal_range(edges.begin(), edges.end(), id);
 		/* Remove potential node (erasing an empty range is safe). */
-		auto insert = n.edges.erase(first, last);
+		auto insert = edges.erase(first, last);
 		/* As the edge list is sorted, a potential edge to last_node will always be the last edge. */
-		if (!n.edges.empty() && n.edges.back().dest_node == last_node) {
+		if (!edges.empty() && edges.back().dest_node == last_node) {
 			/* Change dest ID and move into the spot of the deleted edge. */
-			n.edges.back().dest_node = id;
-			n.edges.insert(insert, n.edges.back());
-			n.edges.pop_back();
+			edges.back().dest_node = id;
+			edges.insert(insert, edges.back());
+			edges.pop_back();
 		}
 	}
 }
@@ -168,7 +200,8 @@ void LinkGraph::BaseNode::AddEdge(NodeID to, uint capacity, uint usage, uint32_t
 {
 	assert(!this->HasEdgeTo(to));
 
-	BaseEdge &edge = *this->edges.emplace(std::upper_bound(this->edges.begin(), this->edges.end(), to), to);
+	std::vector<BaseEdge> &edges = this->GetMutableEdges();
+	BaseEdge &edge = *edges.emplace(std::upper_bound(edges.begin(), edges.end(), to), to);
 	edge.capacity = capacity;
 	edge.usage = usage;
 	edge.travel_time_sum = static_cast<uint64_t>(travel_time) * capacity;
@@ -200,8 +233,9 @@ void LinkGraph::BaseNode::UpdateEdge(NodeID to, uint capacity, uint usage, uint3
  */
 void LinkGraph::BaseNode::RemoveEdge(NodeID to)
 {
-	auto [first, last] = std::equal_range(this->edges.begin(), this->edges.end(), to);
-	this->edges.erase(first, last);
+	std::vector<BaseEdge> &edges = this->GetMutableEdges();
+	auto [first, last] = std::equal_range(edges.begin(), edges.end(), to);
+	edges.erase(first, last);
 }
 
 /**
@@ -89,13 +89,12 @@ public:
 	 */
 	struct BaseNode {
 		uint supply = 0; ///< Supply at the station.
+		uint demand_supply = 0; ///< Supply the demands are calculated with; only follows #supply when that changes noticeably.
 		uint demand = 0; ///< Acceptance at the station.
 		StationID station = StationID::Invalid(); ///< Station ID.
 		TileIndex xy = INVALID_TILE; ///< Location of the station referred to by the node.
 		TimerGameEconomy::Date last_update{}; ///< When the supply was last updated.
 
-		std::vector<BaseEdge> edges; ///< Sorted list of outgoing edges from this node.
-
 		BaseNode(TileIndex xy = INVALID_TILE, StationID st = StationID::Invalid(), uint demand = 0);
 
 		/**
@@ -137,7 +136,28 @@ public:
 		 */
 		bool HasEdgeTo(NodeID dest) const
 		{
-			return std::binary_search(this->edges.begin(), this->edges.end(), dest);
+			return std::binary_search(this->edges->begin(), this->edges->end(), dest);
+		}
+
+		/**
+		 * Get the outgoing edges of this node.
+		 * @return Sorted list of the edges.
+		 */
+		const std::vector<BaseEdge> &GetEdges() const
+		{
+			return *this->edges;
+		}
+
+		/**
+		 * Get the outgoing edges of this node for modification. The edges are
+		 * shared with the copies of the link graph made for running jobs until
+		 * they are modified, so copy them first if they are still shared.
+		 * @return Sorted list of the edges.
+		 */
+		std::vector<BaseEdge> &GetMutableEdges()
+		{
+			if (this->edges.use_count() > 1) this->edges = std::make_shared<std::vector<BaseEdge>>(*this->edges);
+			return *this->edges;
 		}
 
 		BaseEdge &operator[](NodeID to)
@@ -153,14 +173,22 @@ public:
 		}
 
 	private:
+		/**
+		 * Sorted list of outgoing edges from this node. Copying the node only
+		 * shares the list; as link graphs are only copied and modified in the
+		 * main thread the shared list can be read by jobs without locking.
+		 */
+		std::shared_ptr<std::vector<BaseEdge>> edges = std::make_shared<std::vector<BaseEdge>>();
+
 		std::vector<BaseEdge>::iterator GetEdge(NodeID dest)
 		{
-			return std::lower_bound(this->edges.begin(), this->edges.end(), dest);
+			std::vector<BaseEdge> &edges = this->GetMutableEdges();
+			return std::lower_bound(edges.begin(), edges.end(), dest);
 		}
 
 		std::vector<BaseEdge>::const_iterator GetEdge(NodeID dest) const
 		{
-			return std::lower_bound(this->edges.begin(), this->edges.end(), dest);
+			return std::lower_bound(this->edges->begin(), this->edges->end(), dest);
 		}
 	};
 
@@ -175,6 +203,9 @@ public:
 	/** Minimum number of days between subsequent compressions of a LG. */
 	static constexpr TimerGameEconomy::Date COMPRESSION_INTERVAL{256};
 
+	/** Changes of supply up to 1 / DEMAND_SUPPLY_TOLERANCE are ignored when calculating demands. */
+	static constexpr uint DEMAND_SUPPLY_TOLERANCE = 16;
+
 	/**
 	 * Scale a value from a link graph of age orig_age for usage in one of age
 	 * target_age. Make sure that the value stays > 0 if it was > 0 before.
@@ -195,11 +226,13 @@ public:
 	 * @param cargo Cargo the link graph is about.
 	 */
 	LinkGraph(CargoType cargo) : cargo(cargo), last_compression(TimerGameEconomy::date) {}
+	~LinkGraph();
 
 	void Init(uint size);
 	void ShiftDates(TimerGameEconomy::Date interval);
 	void Compress();
 	void Merge(LinkGraph *other);
+	void UpdateDemandSupplies();
 
 	/* Splitting link graphs is intentionally not implemented.
 	 * The overhead in determining connectedness would probably outweigh the
@@ -93,7 +93,7 @@ void LinkGraphOverlay::RebuildCache()
 
 			ConstNode &from_node = lg[sta->goods[cargo].node];
 			supply += lg.Monthly(from_node.supply);
-			for (const Edge &edge : from_node.edges) {
+			for (const Edge &edge : from_node.GetEdges()) {
 				StationID to = lg[edge.dest_node].station;
 				assert(from != to);
 				if (!Station::IsValidID(to) || seen_links.find(to) != seen_links.end()) {
@@ -29,7 +29,9 @@ INSTANTIATE_POOL_METHODS(LinkGraphJob)
 /**
  * Create a link graph job from a link graph. The link graph will be copied so
  * that the calculations don't interfer with the normal operations on the
- * original. The job is immediately started.
+ * original. The edges are only shared by the copy; the original copies the
+ * edges of a node once they are modified while the job is running.
+ * The job is immediately started.
  * @param orig Original LinkGraph to be copied.
  */
 LinkGraphJob::LinkGraphJob(const LinkGraph &orig) :
@@ -41,17 +43,6 @@ LinkGraphJob::LinkGraphJob(const LinkGraph &orig) :
 {
 }
 
-/**
- * Erase all flows originating at a specific station.
- * @param from StationID to erase flows for.
- */
-void LinkGraphJob::EraseFlows(StationID from)
-{
-	for (NodeID node_id = 0; node_id < this->Size(); ++node_id) {
-		(*this)[node_id].flows.erase(from);
-	}
-}
-
 /**
  * Spawn a thread if possible and run the link graph job in the thread. If
  * that's not possible run the job right now in the current thread.
@@ -86,92 +77,130 @@ void LinkGraphJob::JoinThread()
 LinkGraphJob::~LinkGraphJob()
 {
 	this->JoinThread();
+}
 
-	/* Don't update stuff from other pools, when everything is being removed.
-	 * Accessing other pools may be invalid. */
-	if (CleaningPool()) return;
+/**
+ * Get a station of this job, if it still is at the same node of the link graph.
+ * Link graph merging and station deletion may change around IDs, so make sure
+ * that everything is still consistent before merging flows of the station.
+ * @param station The station to look up.
+ * @return The station, or \c nullptr if it has been deleted or changed its node.
+ */
+Station *LinkGraphJob::GetConsistentStation(StationID station) const
+{
+	Station *st = Station::GetIfValid(station);
+	if (st == nullptr) return nullptr;
 
-	/* If the job has been aborted, the job state is invalid.
-	 * This should never be reached, as once the job has been marked as aborted
-	 * the only valid job operation is to clear the LinkGraphJob pool. */
-	assert(!this->IsJobAborted());
+	const GoodsEntry &ge = st->goods[this->Cargo()];
+	if (ge.link_graph != this->link_graph.index || ge.node >= this->nodes.size() || this->nodes[ge.node].base.station != station) return nullptr;
+	return st;
+}
 
-	/* Link graph has been merged into another one. */
-	if (!LinkGraph::IsValidID(this->link_graph.index)) return;
+/**
+ * Merge the flows calculated for a node into the flows of its station.
+ * @param node_id The node to merge.
+ */
+void LinkGraphJob::MergeNodeFlows(NodeID node_id)
+{
+	NodeAnnotation &from = this->nodes[node_id];
 
-	uint16_t size = this->Size();
-	for (NodeID node_id = 0; node_id < size; ++node_id) {
-		NodeAnnotation &from = this->nodes[node_id];
+	Station *st = this->GetConsistentStation(from.base.station);
+	if (st == nullptr) return;
 
-		/* The station can have been deleted. Remove all flows originating from it then. */
-		Station *st = Station::GetIfValid(from.base.station);
-		if (st == nullptr) {
-			this->EraseFlows(from.base.station);
-			continue;
-		}
+	GoodsEntry &ge = st->goods[this->Cargo()];
+	/* Only read from the link graph, so its edges stay shared with running jobs. */
+	const LinkGraph &lg = *LinkGraph::Get(ge.link_graph);
+	FlowStatMap &flows = from.flows;
+	FlowStatMap &geflows = ge.GetOrCreateData().flows;
 
-		/* Link graph merging and station deletion may change around IDs. Make
-		 * sure that everything is still consistent or ignore it otherwise. */
-		GoodsEntry &ge = st->goods[this->Cargo()];
-		if (ge.link_graph != this->link_graph.index || ge.node != node_id) {
-			this->EraseFlows(from.base.station);
-			continue;
+	/* Drop the flows originating at stations that have been deleted or
+	 * changed their node, so they don't end up at this station. */
+	for (FlowStatMap::iterator it(flows.begin()); it != flows.end();) {
+		if (this->GetConsistentStation(it->first) == nullptr) {
+			it = flows.erase(it);
+		} else {
+			++it;
 		}
+	}
 
-		LinkGraph *lg = LinkGraph::Get(ge.link_graph);
-		FlowStatMap &flows = from.flows;
-		FlowStatMap &geflows = ge.GetOrCreateData().flows;
-
-		for (const auto &edge : from.edges) {
-			if (edge.Flow() == 0) continue;
-			NodeID dest_id = edge.base.dest_node;
-			StationID to = this->nodes[dest_id].base.station;
-			Station *st2 = Station::GetIfValid(to);
-			if (st2 == nullptr || st2->goods[this->Cargo()].link_graph != this->link_graph.index ||
-					st2->goods[this->Cargo()].node != dest_id ||
-					!(*lg)[node_id].HasEdgeTo(dest_id) ||
-					(*lg)[node_id][dest_id].LastUpdate() == EconomyTime::INVALID_DATE) {
-				/* Edge has been removed. Delete flows. */
-				StationIDStack erased = flows.DeleteFlows(to);
-				/* Delete old flows for source stations which have been deleted
-				 * from the new flows. This avoids flow cycles between old and
-				 * new flows. */
-				while (!erased.IsEmpty()) geflows.erase(erased.Pop());
-			} else if ((*lg)[node_id][dest_id].last_unrestricted_update == EconomyTime::INVALID_DATE) {
-				/* Edge is fully restricted. */
-				flows.RestrictFlows(to);
-			}
+	for (const auto &edge : from.edges) {
+		if (edge.Flow() == 0) continue;
+		NodeID dest_id = edge.base.dest_node;
+		StationID to = this->nodes[dest_id].base.station;
+		Station *st2 = Station::GetIfValid(to);
+		if (st2 == nullptr || st2->goods[this->Cargo()].link_graph != this->link_graph.index ||
+				st2->goods[this->Cargo()].node != dest_id ||
+				!lg[node_id].HasEdgeTo(dest_id) ||
+				lg[node_id][dest_id].LastUpdate() == EconomyTime::INVALID_DATE) {
+			/* Edge has been removed. Delete flows. */
+			StationIDStack erased = flows.DeleteFlows(to);
+			/* Delete old flows for source stations which have been deleted
+			 * from the new flows. This avoids flow cycles between old and
+			 * new flows. */
+			while (!erased.IsEmpty()) geflows.erase(erased.Pop());
+		} else if (lg[node_id][dest_id].last_unrestricted_update == EconomyTime::INVALID_DATE) {
+			/* Edge is fully restricted. */
+			flows.RestrictFlows(to);
 		}
+	}
 
-		/* Swap shares and invalidate ones that are completely deleted. Don't
-		 * really delete them as we could then end up with unroutable cargo
-		 * somewhere. Do delete them and also reroute relevant cargo if
-		 * automatic distribution has been turned off for that cargo. */
-		for (FlowStatMap::iterator it(geflows.begin()); it != geflows.end();) {
-			FlowStatMap::iterator new_it = flows.find(it->first);
-			if (new_it == flows.end()) {
-				if (_settings_game.linkgraph.GetDistributionType(this->Cargo()) != DT_MANUAL) {
-					it->second.Invalidate();
-					++it;
-				} else {
-					FlowStat shares(StationID::Invalid(), 1);
-					it->second.SwapShares(shares);
-					geflows.erase(it++);
-					for (FlowStat::SharesMap::const_iterator shares_it(shares.GetShares()->begin());
-							shares_it != shares.GetShares()->end(); ++shares_it) {
-						RerouteCargo(st, this->Cargo(), shares_it->second, st->index);
-					}
-				}
-			} else {
-				it->second.SwapShares(new_it->second);
-				flows.erase(new_it);
+	/* Swap shares and invalidate ones that are completely deleted. Don't
+	 * really delete them as we could then end up with unroutable cargo
+	 * somewhere. Do delete them and also reroute relevant cargo if
+	 * automatic distribution has been turned off for that cargo. */
+	for (FlowStatMap::iterator it(geflows.begin()); it != geflows.end();) {
+		FlowStatMap::iterator new_it = flows.find(it->first);
+		if (new_it == flows.end()) {
+			if (_settings_game.linkgraph.GetDistributionType(this->Cargo()) != DT_MANUAL) {
+				it->second.Invalidate();
 				++it;
+			} else {
+				FlowStat shares(StationID::Invalid(), 1);
+				it->second.SwapShares(shares);
+				geflows.erase(it++);
+				for (FlowStat::SharesMap::const_iterator shares_it(shares.GetShares()->begin());
+						shares_it != shares.GetShares()->end(); ++shares_it) {
+					RerouteCargo(st, this->Cargo(), shares_it->second, st->index);
+				}
 			}
+		} else {
+			it->second.SwapShares(new_it->second);
+			flows.erase(new_it);
+			++it;
 		}
-		geflows.insert(flows.begin(), flows.end());
-		if (ge.GetData().IsEmpty()) ge.ClearData();
-		InvalidateWindowData(WC_STATION_VIEW, st->index, this->Cargo());
 	}
+	geflows.insert(flows.begin(), flows.end());
+	if (ge.GetData().IsEmpty()) ge.ClearData();
+	InvalidateWindowData(WC_STATION_VIEW, st->index, this->Cargo());
+}
+
+/**
+ * Merge the results of the finished job into the flows of the stations.
+ * To avoid stalling the game on large link graphs, the nodes are merged in
+ * order and the merging is interrupted after about #MERGE_STEP_SIZE edges
+ * and flows; it is continued by calling this again in the next tick.
+ * @return True if all nodes have been merged, false if there are more to merge.
+ */
+bool LinkGraphJob::MergeFlows()
+{
+	/* If the job has been aborted, the job state is invalid.
+	 * This should never be reached, as once the job has been marked as aborted
+	 * the only valid job operation is to clear the LinkGraphJob pool. */
+	assert(!this->IsJobAborted());
+
+	/* Link graph has been merged into another one. */
+	if (!LinkGraph::IsValidID(this->link_graph.index)) return true;
+
+	uint work = 0;
+	while (this->merged_nodes < this->Size()) {
+		if (work >= MERGE_STEP_SIZE) return false;
+
+		const NodeAnnotation &node = this->nodes[this->merged_nodes];
+		work += 1 + static_cast<uint>(node.edges.size() + node.flows.size());
+		this->MergeNodeFlows(this->merged_nodes);
+		++this->merged_nodes;
+	}
+	return true;
 }
 
 /**
@@ -86,10 +86,10 @@ public:
 		std::vector<EdgeAnnotation> edges{}; ///< Annotations for all edges originating at this node.
 		std::vector<DemandAnnotation> demands{}; ///< Annotations for the demand to all other nodes.
 
-		NodeAnnotation(const LinkGraph::BaseNode &node, size_t size) : base(node), undelivered_supply(node.supply)
+		NodeAnnotation(const LinkGraph::BaseNode &node, size_t size) : base(node), undelivered_supply(node.demand_supply)
 		{
-			this->edges.reserve(node.edges.size());
-			for (auto &e : node.edges) this->edges.emplace_back(e);
+			this->edges.reserve(node.GetEdges().size());
+			for (auto &e : node.GetEdges()) this->edges.emplace_back(e);
 			this->demands.resize(size);
 		}
 
@@ -159,19 +159,24 @@ private:
 	friend class LinkGraphSchedule;
 
 protected:
-	const LinkGraph link_graph; ///< Link graph to by analyzed. Is copied when job is started and mustn't be modified later.
+	const LinkGraph link_graph; ///< Link graph to by analyzed. Is copied when job is started, sharing the edges with the original, and mustn't be modified later.
 	const LinkGraphSettings settings; ///< Copy of _settings_game.linkgraph at spawn time.
 	std::thread thread{}; ///< Thread the job is running in or a default-constructed thread if it's running in the main thread.
 	TimerGameEconomy::Date join_date = EconomyTime::INVALID_DATE; ///< Date when the job is to be joined.
 	NodeAnnotationVector nodes{}; ///< Extra node data necessary for link graph calculation.
 	std::atomic<bool> job_completed = false; ///< Is the job still running. This is accessed by multiple threads and reads may be stale.
 	std::atomic<bool> job_aborted = false; ///< Has the job been aborted. This is accessed by multiple threads and reads may be stale.
+	NodeID merged_nodes = 0; ///< Number of nodes whose flows have been merged into their stations.
 
-	void EraseFlows(StationID from);
 	void JoinThread();
 	void SpawnThread();
+	Station *GetConsistentStation(StationID station) const;
+	void MergeNodeFlows(NodeID node_id);
+	bool MergeFlows();
 
 public:
+	static const uint MERGE_STEP_SIZE = 4096; ///< Number of edges and flows after which merging the results is continued in the next tick.
+
 	/**
 	 * Bare constructor, only for save/load. link_graph, join_date and actually
 	 * settings have to be brutally const-casted in order to populate them.
@@ -211,6 +216,12 @@ public:
 	 */
 	inline bool IsScheduledToBeJoined() const { return this->join_date <= TimerGameEconomy::date; }
 
+	/**
+	 * Check if the results of the job are being merged into the stations.
+	 * @return True if some, but not all, nodes have been merged.
+	 */
+	inline bool IsMergeInProgress() const { return this->merged_nodes > 0; }
+
 	/**
 	 * Get the date when the job should be finished.
 	 * @return Join date.
@@ -43,6 +43,7 @@ void LinkGraphSchedule::SpawnNext()
 	assert(next == LinkGraph::Get(next->index));
 	this->schedule.pop_front();
 	if (LinkGraphJob::CanAllocateItem()) {
+		next->UpdateDemandSupplies();
 		LinkGraphJob *job = new LinkGraphJob(*next);
 		job->SpawnThread();
 		this->running.push_back(job);
@@ -63,20 +64,36 @@ bool LinkGraphSchedule::IsJoinWithUnfinishedJobDue() const
 }
 
 /**
- * Join the next finished job, if available.
+ * Check if the results of the next job are being merged over multiple ticks.
+ * @return True if merging has to be continued in this tick.
+ */
+bool LinkGraphSchedule::IsMergeInProgress() const
+{
+	return !this->running.empty() && this->running.front()->IsMergeInProgress();
+}
+
+/**
+ * Join the next finished job, if available, and merge its results. On large
+ * link graphs merging is spread over multiple ticks; the job is only removed
+ * when all of its results have been merged.
  */
 void LinkGraphSchedule::JoinNext()
 {
 	if (this->running.empty()) return;
 	LinkGraphJob *next = this->running.front();
 	if (!next->IsScheduledToBeJoined()) return;
+	next->JoinThread();
+	if (!next->MergeFlows()) return;
 	this->running.pop_front();
 	LinkGraphID id = next->LinkGraphIndex();
-	delete next; // implicitly joins the thread
+	delete next;
 	if (LinkGraph::IsValidID(id)) {
 		LinkGraph *lg = LinkGraph::Get(id);
 		this->Unqueue(lg); // Unqueue to avoid double-queueing recycled IDs.
 		this->Queue(lg);
+	} else {
+		/* The job might have cached its demands after the link graph was deleted. */
+		ClearDemandCache(id);
 	}
 }
 
@@ -86,6 +103,8 @@ void LinkGraphSchedule::JoinNext()
  */
 /* static */ void LinkGraphSchedule::Run(LinkGraphJob *job)
 {
+	PerformanceTraceScope trace("Link graph job", "ottd:linkgraph");
+
 	for (const auto &handler : instance.handlers) {
 		if (job->IsJobAborted()) return;
 		handler->Run(*job);
@@ -125,6 +144,7 @@ void LinkGraphSchedule::SpawnAll()
 	}
 	instance.running.clear();
 	instance.schedule.clear();
+	ClearDemandCache();
 }
 
 /**
@@ -201,19 +221,25 @@ void AfterLoad_LinkGraphPauseControl()
  */
 void OnTick_LinkGraph()
 {
-	if (TimerGameEconomy::date_fract != LinkGraphSchedule::SPAWN_JOIN_TICK) return;
-	TimerGameEconomy::Date offset{TimerGameEconomy::date.base() % (_settings_game.linkgraph.recalc_interval / EconomyTime::SECONDS_PER_DAY)};
-	if (offset == 0) {
-		LinkGraphSchedule::instance.SpawnNext();
-	} else if (offset == (_settings_game.linkgraph.recalc_interval / EconomyTime::SECONDS_PER_DAY) / 2) {
-		if (!_networking || _network_server) {
-			PerformanceMeasurer::SetInactive(PFE_GL_LINKGRAPH);
-			LinkGraphSchedule::instance.JoinNext();
-		} else {
-			PerformanceMeasurer framerate(PFE_GL_LINKGRAPH);
-			LinkGraphSchedule::instance.JoinNext();
+	/* Merging the results of a joined job continues every tick until it is done. */
+	bool join = LinkGraphSchedule::instance.IsMergeInProgress();
+	if (TimerGameEconomy::date_fract == LinkGraphSchedule::SPAWN_JOIN_TICK) {
+		TimerGameEconomy::Date offset{TimerGameEconomy::date.base() % (_settings_game.linkgraph.recalc_interval / EconomyTime::SECONDS_PER_DAY)};
+		if (offset == 0) {
+			LinkGraphSchedule::instance.SpawnNext();
+		} else if (offset == (_settings_game.linkgraph.recalc_interval / EconomyTime::SECONDS_PER_DAY) / 2) {
+			join = true;
 		}
 	}
+	if (!join) return;
+
+	if (!_networking || _network_server) {
+		PerformanceMeasurer::SetInactive(PFE_GL_LINKGRAPH);
+		LinkGraphSchedule::instance.JoinNext();
+	} else {
+		PerformanceMeasurer framerate(PFE_GL_LINKGRAPH);
+		LinkGraphSchedule::instance.JoinNext();
+	}
 }
 
 
@@ -56,6 +56,7 @@ public:
 
 	void SpawnNext();
 	bool IsJoinWithUnfinishedJobDue() const;
+	bool IsMergeInProgress() const;
 	void JoinNext();
 	void SpawnAll();
 	void ShiftDates(TimerGameEconomy::Date interval);
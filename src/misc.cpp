@@ -18,6 +18,7 @@
 #include "timer/timer_game_calendar.h"
 #include "timer/timer_game_economy.h"
 #include "timer/timer_game_tick.h"
+#include "timer/timer.h"
 #include "texteff.hpp"
 #include "gfx_func.h"
 #include "gamelog.h"
@@ -120,6 +121,9 @@ void InitializeGame(uint size_x, uint size_y, bool reset_date, bool reset_settin
 		InitializeOldNames();
 	}
 
+	/* Work of a period of the previous game must not be continued; older savegames did all work at once. */
+	AmortizedTimer<TimerGameEconomy>::ResetAll();
+
 	LinkGraphSchedule::Clear();
 	PoolBase::Clean(PoolType::Normal);
 
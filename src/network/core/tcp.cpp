@@ -43,7 +43,10 @@ NetworkRecvStatus NetworkTCPSocketHandler::CloseConnection([[maybe_unused]] bool
 	this->MarkClosed();
 	this->writable = false;
 
-	this->packet_queue.clear();
+	{
+		std::lock_guard<std::mutex> lock(this->packet_queue_mutex);
+		this->packet_queue.clear();
+	}
 	this->packet_recv = nullptr;
 
 	return NETWORK_RECV_STATUS_OKAY;
@@ -60,6 +63,8 @@ void NetworkTCPSocketHandler::SendPacket(std::unique_ptr<Packet> &&packet)
 	assert(packet != nullptr);
 
 	packet->PrepareToSend();
+
+	std::lock_guard<std::mutex> lock(this->packet_queue_mutex);
 	this->packet_queue.push_back(std::move(packet));
 }
 
@@ -79,6 +84,7 @@ SendPacketsState NetworkTCPSocketHandler::SendPackets(bool closing_down)
 	if (!this->writable) return SPS_NONE_SENT;
 	if (!this->IsConnected()) return SPS_CLOSED;
 
+	std::unique_lock<std::mutex> lock(this->packet_queue_mutex);
 	while (!this->packet_queue.empty()) {
 		Packet &p = *this->packet_queue.front();
 		ssize_t res = p.TransferOut(SocketSender{this->sock});
@@ -88,6 +94,7 @@ SendPacketsState NetworkTCPSocketHandler::SendPackets(bool closing_down)
 				/* Something went wrong.. close client! */
 				if (!closing_down) {
 					Debug(net, 0, "Send failed: {}", err.AsString());
+					lock.unlock();
 					this->CloseConnection();
 				}
 				return SPS_CLOSED;
@@ -96,6 +103,7 @@ SendPacketsState NetworkTCPSocketHandler::SendPackets(bool closing_down)
 		}
 		if (res == 0) {
 			/* Client/server has left us :( */
+			lock.unlock();
 			if (!closing_down) this->CloseConnection();
 			return SPS_CLOSED;
 		}
@@ -112,6 +120,26 @@ SendPacketsState NetworkTCPSocketHandler::SendPackets(bool closing_down)
 	return SPS_ALL_SENT;
 }
 
+/**
+ * Send as many of the queued packets as possible from a thread other than
+ * the one handling this socket. Failures are not handled here, but left to
+ * the next call to #SendPackets, which will run into them again.
+ * The caller must make sure the socket is not closed meanwhile.
+ */
+void NetworkTCPSocketHandler::SendPacketsInBackground()
+{
+	std::unique_lock<std::mutex> lock(this->packet_queue_mutex, std::try_to_lock);
+	if (!lock.owns_lock() || !this->writable || !this->IsConnected()) return;
+
+	while (!this->packet_queue.empty()) {
+		Packet &p = *this->packet_queue.front();
+		if (p.TransferOut(SocketSender{this->sock}) <= 0) return;
+		if (p.RemainingBytesToTransfer() != 0) return;
+
+		this->packet_queue.pop_front();
+	}
+}
+
 /**
  * Receives a packet for the given client
  * @return The received packet (or nullptr when it didn't receive one)
@@ -17,6 +17,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <mutex>
 #include <thread>
 
 /** The states of sending the packets. */
@@ -31,6 +32,7 @@ enum SendPacketsState : uint8_t {
 class NetworkTCPSocketHandler : public NetworkSocketHandler {
 private:
 	std::deque<std::unique_ptr<Packet>> packet_queue{}; ///< Packets that are awaiting delivery. Cannot be std::queue as that does not have a clear() function.
+	std::mutex packet_queue_mutex; ///< Mutex for #packet_queue, as it may be sent from a background thread.
 	std::unique_ptr<Packet> packet_recv = nullptr; ///< Partially received packet
 
 	void EmptyPacketQueue();
@@ -49,6 +51,7 @@ public:
 
 	virtual void SendPacket(std::unique_ptr<Packet> &&packet);
 	SendPacketsState SendPackets(bool closing_down = false);
+	void SendPacketsInBackground();
 
 	virtual std::unique_ptr<Packet> ReceivePacket();
 
@@ -58,7 +61,11 @@ public:
 	 * Whether there is something pending in the send queue.
 	 * @return true when something is pending in the send queue.
 	 */
-	bool HasSendQueue() { return !this->packet_queue.empty(); }
+	bool HasSendQueue()
+	{
+		std::lock_guard<std::mutex> lock(this->packet_queue_mutex);
+		return !this->packet_queue.empty();
+	}
 
 	/**
 	 * Construct a socket handler for a TCP connection.
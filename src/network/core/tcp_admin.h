@@ -65,6 +65,7 @@ enum PacketAdminType : uint8_t {
 	ADMIN_PACKET_SERVER_CMD_LOGGING,     ///< The server gives the admin copies of incoming command packets.
 	ADMIN_PACKET_SERVER_AUTH_REQUEST,    ///< The server gives the admin the used authentication method and required parameters.
 	ADMIN_PACKET_SERVER_ENABLE_ENCRYPTION, ///< The server tells that authentication has completed and requests to enable encryption with the keys of the last \c ADMIN_PACKET_ADMIN_AUTH_RESPONSE.
+	ADMIN_PACKET_SERVER_PERFORMANCE,     ///< The server tells the admin how well the game loop keeps up.
 
 	INVALID_ADMIN_PACKET = 0xFF,         ///< An invalid marker for admin packets.
 };
@@ -89,6 +90,7 @@ enum AdminUpdateType : uint8_t {
 	ADMIN_UPDATE_CMD_NAMES,       ///< The admin would like a list of all DoCommand names.
 	ADMIN_UPDATE_CMD_LOGGING,     ///< The admin would like to have DoCommand information.
 	ADMIN_UPDATE_GAMESCRIPT,      ///< The admin would like to have gamescript messages.
+	ADMIN_UPDATE_PERFORMANCE,     ///< Updates about how well the game loop keeps up.
 	ADMIN_UPDATE_END,             ///< Must ALWAYS be on the end of this list!! (period)
 };
 
@@ -530,6 +532,18 @@ protected:
 	 */
 	virtual NetworkRecvStatus Receive_SERVER_PONG(Packet &p);
 
+	/**
+	 * Send how well the game loop keeps up with its schedule:
+	 * uint32_t  Average duration of the recent game ticks, in microseconds.
+	 * uint32_t  Number of game ticks run in about the last second, in thousandths.
+	 * uint32_t  How late the last game tick started, in microseconds.
+	 * uint64_t  Number of game ticks given up on since the start, as the game loop was too far behind.
+	 * uint32_t  Duration of the longest game tick in the previous economy month, in microseconds.
+	 * @param p The packet that was just received.
+	 * @return The state the network should have.
+	 */
+	virtual NetworkRecvStatus Receive_SERVER_PERFORMANCE(Packet &p);
+
 	/**
 	 * Notify the admin connection that the rcon command has finished.
 	 * string The command as requested by the admin connection.
@@ -312,6 +312,9 @@ protected:
 	 * uint32_t  Frame counter.
 	 * uint32_t  General seed 1.
 	 * uint32_t  General seed 2 (dependent on compile settings, not default).
+	 * Optionally followed by:
+	 * uint8_t   Number of hashes of parts of the game state.
+	 * uint32_t  Hash of each part of the game state, see #StateHashPart.
 	 * @param p The packet that was just received.
 	 */
 	virtual NetworkRecvStatus Receive_SERVER_SYNC(Packet &p);
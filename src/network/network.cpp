@@ -85,6 +85,7 @@ uint32_t _sync_seed_1;                  ///< Seed to compare during sync checks.
 uint32_t _sync_seed_2;                  ///< Second part of the seed.
 #endif
 uint32_t _sync_frame;                   ///< The frame to perform the sync check.
+std::optional<StateHash> _sync_state_hash; ///< Hashes of the game state to compare during the sync check, if the server sent them.
 bool _network_first_time;             ///< Whether we have finished joining or not.
 
 /** The amount of clients connected */
@@ -593,6 +594,8 @@ static void InitializeNetworkPools(bool close_admins = true)
 void NetworkClose(bool close_admins)
 {
 	if (_network_server) {
+		NetworkServerStopBackgroundSend();
+
 		if (close_admins) {
 			for (ServerNetworkAdminSocketHandler *as : ServerNetworkAdminSocketHandler::Iterate()) {
 				as->CloseConnection(true);
@@ -632,6 +635,7 @@ static void NetworkInitialize(bool close_admins = true)
 	InitializeNetworkPools(close_admins);
 
 	_sync_frame = 0;
+	_sync_state_hash.reset();
 	_network_first_time = true;
 
 	_network_reconnect = 0;
@@ -1252,8 +1256,10 @@ void NetworkGameLoop()
 
 		NetworkExecuteLocalCommandQueue();
 
-		/* Then we make the frame */
+		/* Then we make the frame, while the packets that are still queued are sent meanwhile. */
+		NetworkServerBeginBackgroundSend();
 		StateGameLoop();
+		NetworkServerEndBackgroundSend();
 
 		_sync_seed_1 = _random.state[0];
 #ifdef NETWORK_SEND_DOUBLE_SEED
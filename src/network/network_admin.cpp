@@ -22,6 +22,8 @@
 #include "../map_func.h"
 #include "../rev.h"
 #include "../game/game.hpp"
+#include "../framerate_type.h"
+#include "../video/video_driver.hpp"
 
 #include "table/strings.h"
 
@@ -56,6 +58,7 @@ static const AdminUpdateFrequencies _admin_update_type_frequencies[] = {
 	{AdminUpdateFrequency::Poll,                                                                                                                                                          }, // ADMIN_UPDATE_CMD_NAMES
 	{                            AdminUpdateFrequency::Automatic,                                                                                                                         }, // ADMIN_UPDATE_CMD_LOGGING
 	{                            AdminUpdateFrequency::Automatic,                                                                                                                         }, // ADMIN_UPDATE_GAMESCRIPT
+	{AdminUpdateFrequency::Poll, AdminUpdateFrequency::Daily, AdminUpdateFrequency::Weekly, AdminUpdateFrequency::Monthly, AdminUpdateFrequency::Quarterly, AdminUpdateFrequency::Annually}, // ADMIN_UPDATE_PERFORMANCE
 };
 /** Sanity check. */
 static_assert(lengthof(_admin_update_type_frequencies) == ADMIN_UPDATE_END);
@@ -214,6 +217,22 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::SendDate()
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
+/** Tell the admin how well the game loop keeps up. */
+NetworkRecvStatus ServerNetworkAdminSocketHandler::SendPerformance()
+{
+	auto p = std::make_unique<Packet>(this, ADMIN_PACKET_SERVER_PERFORMANCE);
+
+	const VideoDriver *driver = VideoDriver::GetInstance();
+	p->Send_uint32(ClampTo<uint32_t>(std::llround(GetPerformanceAverageDuration(PFE_GAMELOOP, Ticks::DAY_TICKS) * 1000)));
+	p->Send_uint32(ClampTo<uint32_t>(std::llround(GetPerformanceRate(PFE_GAMELOOP) * 1000)));
+	p->Send_uint32(ClampTo<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(driver->GetGameLag()).count()));
+	p->Send_uint64(driver->GetSkippedGameTicks());
+	p->Send_uint32(ClampTo<uint32_t>(std::llround(GetPerformancePeakDuration(PFE_GAMELOOP) * 1000)));
+	this->SendPacket(std::move(p));
+
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
 /**
  * Tell the admin that a client joined.
  * @param client_id The client that joined.
@@ -691,6 +710,11 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::Receive_ADMIN_POLL(Packet &p)
 			this->SendDate();
 			break;
 
+		case ADMIN_UPDATE_PERFORMANCE:
+			/* The admin is requesting how well the game loop keeps up. */
+			this->SendPerformance();
+			break;
+
 		case ADMIN_UPDATE_CLIENT_INFO:
 			/* The admin is requesting client info. */
 			if (d1 == UINT32_MAX) {
@@ -1070,6 +1094,10 @@ void NetworkAdminUpdate(AdminUpdateFrequency freq)
 						as->SendDate();
 						break;
 
+					case ADMIN_UPDATE_PERFORMANCE:
+						as->SendPerformance();
+						break;
+
 					case ADMIN_UPDATE_COMPANY_ECONOMY:
 						as->SendCompanyEconomy();
 						break;
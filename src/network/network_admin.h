@@ -56,6 +56,7 @@ public:
 	NetworkRecvStatus SendShutdown();
 
 	NetworkRecvStatus SendDate();
+	NetworkRecvStatus SendPerformance();
 	NetworkRecvStatus SendClientJoin(ClientID client_id);
 	NetworkRecvStatus SendClientInfo(const NetworkClientSocket *cs, const NetworkClientInfo *ci);
 	NetworkRecvStatus SendClientUpdate(const NetworkClientInfo *ci);
@@ -234,10 +234,22 @@ void ClientNetworkGameSocketHandler::ClientError(NetworkRecvStatus res)
 	if (_sync_frame != 0) {
 		if (_sync_frame == _frame_counter) {
 #ifdef NETWORK_SEND_DOUBLE_SEED
-			if (_sync_seed_1 != _random.state[0] || _sync_seed_2 != _random.state[1]) {
+			bool in_sync = _sync_seed_1 == _random.state[0] && _sync_seed_2 == _random.state[1];
 #else
-			if (_sync_seed_1 != _random.state[0]) {
+			bool in_sync = _sync_seed_1 == _random.state[0];
 #endif
+			if (_sync_state_hash.has_value()) {
+				const StateHash state_hash = CalculateStateHash();
+				for (StateHashPart part = SHP_MAP_BEGIN; part < SHP_END; part = static_cast<StateHashPart>(part + 1)) {
+					if (state_hash[part] == (*_sync_state_hash)[part]) continue;
+
+					Debug(desync, 0, "State hash mismatch: {}", GetStateHashPartName(part));
+					in_sync = false;
+				}
+				_sync_state_hash.reset();
+			}
+
+			if (!in_sync) {
 				ShowNetworkError(STR_NETWORK_ERROR_DESYNC);
 				Debug(desync, 1, "sync_err: {:08x}; {:02x}", TimerGameEconomy::date, TimerGameEconomy::date_fract);
 				Debug(net, 0, "Sync error detected");
@@ -257,6 +269,7 @@ void ClientNetworkGameSocketHandler::ClientError(NetworkRecvStatus res)
 		} else if (_sync_frame < _frame_counter) {
 			Debug(net, 1, "Missed frame for sync-test: {} / {}", _sync_frame, _frame_counter);
 			_sync_frame = 0;
+			_sync_state_hash.reset();
 		}
 	}
 
@@ -876,6 +889,7 @@ NetworkRecvStatus ClientNetworkGameSocketHandler::Receive_SERVER_FRAME(Packet &p
 	if (p.CanReadFromPacket(sizeof(uint32_t))) {
 #endif
 		_sync_frame = _frame_counter_server;
+		_sync_state_hash.reset();
 		_sync_seed_1 = p.Recv_uint32();
 #ifdef NETWORK_SEND_DOUBLE_SEED
 		_sync_seed_2 = p.Recv_uint32();
@@ -906,6 +920,13 @@ NetworkRecvStatus ClientNetworkGameSocketHandler::Receive_SERVER_SYNC(Packet &p)
 	_sync_seed_2 = p.Recv_uint32();
 #endif
 
+	/* The server may also send hashes of the game state, to tell where a desync occurred. */
+	_sync_state_hash.reset();
+	if (p.CanReadFromPacket(sizeof(uint8_t)) && p.Recv_uint8() == SHP_END && p.CanReadFromPacket(SHP_END * sizeof(uint32_t))) {
+		_sync_state_hash.emplace();
+		for (uint32_t &hash : *_sync_state_hash) hash = p.Recv_uint32();
+	}
+
 	Debug(net, 9, "Client::Receive_SERVER_SYNC(): sync_frame={}, sync_seed_1={}", _sync_frame, _sync_seed_1);
 
 	return NETWORK_RECV_STATUS_OKAY;
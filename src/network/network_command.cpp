@@ -272,6 +272,21 @@ void NetworkExecuteLocalCommandQueue()
 	_current_company = _local_company;
 }
 
+/**
+ * Execute a command of a desync log right away, as if it was received from the server.
+ * @param cp The command to execute.
+ */
+void NetworkReplayCommand(const CommandPacket &cp)
+{
+	_current_company = cp.company;
+	size_t cb_index = FindCallbackIndex(cp.callback);
+	assert(cb_index < _callback_tuple_size);
+	assert(_cmd_dispatch[cp.cmd].Unpack[cb_index] != nullptr);
+	_cmd_dispatch[cp.cmd].Unpack[cb_index](cp);
+
+	_current_company = _local_company;
+}
+
 /**
  * Free the local command queues.
  */
@@ -31,6 +31,7 @@ extern uint8_t _network_reconnect;
 extern StringList _network_bind_list;
 extern StringList _network_host_list;
 extern StringList _network_ban_list;
+extern bool _network_replaying_commands;
 
 uint8_t NetworkSpectatorCount();
 bool NetworkIsValidClientName(std::string_view client_name);
@@ -18,6 +18,7 @@
 #include "../command_func.h"
 #include "../misc/endian_buffer.hpp"
 #include "../strings_type.h"
+#include "../state_hash.h"
 
 #ifdef RANDOM_DEBUG
 /**
@@ -67,6 +68,7 @@ extern uint32_t _sync_seed_1;
 extern uint32_t _sync_seed_2;
 #endif
 extern uint32_t _sync_frame;
+extern std::optional<StateHash> _sync_state_hash;
 extern bool _network_first_time;
 /* Vars needed for the join-GUI */
 extern NetworkJoinStatus _network_join_status;
@@ -108,6 +110,7 @@ void NetworkExecuteLocalCommandQueue();
 void NetworkFreeLocalCommandQueue();
 void NetworkSyncCommandQueue(NetworkClientSocket *cs);
 void NetworkReplaceCommandClientId(CommandPacket &cp, ClientID client_id);
+void NetworkReplayCommand(const CommandPacket &cp);
 
 void ShowNetworkError(StringID error_string);
 void NetworkTextMessage(NetworkAction action, TextColour colour, bool self_send, std::string_view name, std::string_view str = {}, StringParameter &&data = {});
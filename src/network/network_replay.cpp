@@ -0,0 +1,126 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file network_replay.cpp Implementation of replaying the commands of a desync log. */
+
+#include "../stdafx.h"
+#include "network_replay.h"
+#include "../core/random_func.hpp"
+#include "../core/string_consumer.hpp"
+#include "../debug.h"
+#include "../fileio_func.h"
+#include "../string_func.h"
+
+#include <charconv>
+
+#include "../safeguards.h"
+
+/** Whether commands of a desync log are being replayed, so scripts must not issue their own. */
+#ifdef DEBUG_DUMP_COMMANDS
+bool _network_replaying_commands = true;
+#else
+bool _network_replaying_commands = false;
+#endif
+
+/**
+ * Load the entries to replay from a desync log.
+ * @param filename The name of the log, relative to the save directory.
+ * @return True iff the log could be read.
+ */
+bool CommandLogReplay::Load(std::string_view filename)
+{
+	auto f = FioFOpenFile(filename, "rb", SAVE_DIR);
+	if (!f.has_value()) return false;
+
+	this->entries.clear();
+	this->next = 0;
+
+	char buff[4096];
+	while (fgets(buff, lengthof(buff), *f) != nullptr) {
+		StringConsumer consumer{std::string_view{buff}};
+		/* Ignore the "[date time] " part of the message */
+		if (consumer.ReadCharIf('[')) {
+			consumer.SkipUntilChar(']', StringConsumer::SKIP_ONE_SEPARATOR);
+			consumer.SkipCharIf(' ');
+		}
+
+		bool is_command = consumer.ReadIf("cmd: ");
+		if (!is_command && !consumer.ReadIf("sync: ")) continue; // Only commands and sync states affect the replay.
+
+		Entry &entry = this->entries.emplace_back();
+		entry.date = TimerGameEconomy::Date(consumer.ReadIntegerBase<uint32_t>(16));
+		bool valid = consumer.ReadIf("; ");
+		entry.date_fract = consumer.ReadIntegerBase<uint32_t>(16);
+		valid &= consumer.ReadIf("; ");
+
+		if (is_command) {
+			CommandPacket &cp = entry.command.emplace();
+			cp.company = static_cast<CompanyID>(consumer.ReadIntegerBase<uint16_t>(16));
+			valid &= consumer.ReadIf("; ");
+			cp.cmd = static_cast<Commands>(consumer.ReadIntegerBase<uint32_t>(16));
+			valid &= consumer.ReadIf("; ");
+			cp.err_msg = consumer.ReadIntegerBase<uint32_t>(16);
+			valid &= consumer.ReadIf("; ");
+			auto args = consumer.ReadUntilChar(' ', StringConsumer::SKIP_ONE_SEPARATOR);
+			valid &= cp.cmd < CMD_END;
+
+			for (size_t i = 0; i + 1 < args.size(); i += 2) {
+				uint8_t e = 0;
+				std::from_chars(args.data() + i, args.data() + i + 2, e, 16);
+				cp.data.push_back(e);
+			}
+		} else {
+			entry.sync_state[0] = consumer.ReadIntegerBase<uint32_t>(16);
+			valid &= consumer.ReadIf("; ");
+			entry.sync_state[1] = consumer.ReadIntegerBase<uint32_t>(16);
+		}
+
+		if (!valid) {
+			Debug(desync, 0, "Cannot parse: {}", buff);
+			this->entries.pop_back();
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Replay the entries for the current moment of the game. This is to be called before
+ * each tick, which is when the server recorded the sync state and executed the commands.
+ * @return False iff the game state does not match the recorded sync state.
+ */
+bool CommandLogReplay::Replay()
+{
+	for (; this->next < this->entries.size(); this->next++) {
+		const Entry &entry = this->entries[this->next];
+		if (std::tie(entry.date, entry.date_fract) > std::tie(TimerGameEconomy::date, TimerGameEconomy::date_fract)) break;
+
+		if (std::tie(entry.date, entry.date_fract) < std::tie(TimerGameEconomy::date, TimerGameEconomy::date_fract)) {
+			Debug(desync, 1, "Skipping entry at {:08x}:{:02x}", entry.date, entry.date_fract);
+			this->skipped++;
+			continue;
+		}
+
+		if (entry.command.has_value()) {
+			const CommandPacket &cp = *entry.command;
+			Debug(desync, 2, "Injecting: {:08x}; {:02x}; {:02x}; {:08x}; {} ({})", entry.date, entry.date_fract, cp.company.base(), cp.cmd, FormatArrayAsHex(cp.data), GetCommandName(cp.cmd));
+			NetworkReplayCommand(cp);
+			this->commands++;
+			continue;
+		}
+
+		if (entry.sync_state[0] != _random.state[0] || entry.sync_state[1] != _random.state[1]) {
+			Debug(desync, 0, "Sync check: {:08x}; {:02x}; mismatch expected {{{:08x}, {:08x}}}, got {{{:08x}, {:08x}}}",
+					entry.date, entry.date_fract, entry.sync_state[0], entry.sync_state[1], _random.state[0], _random.state[1]);
+			this->next++;
+			return false;
+		}
+		this->sync_checks++;
+	}
+
+	return true;
+}
@@ -0,0 +1,49 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file network_replay.h Replaying the commands of a desync log. */
+
+#ifndef NETWORK_REPLAY_H
+#define NETWORK_REPLAY_H
+
+#include "network_internal.h"
+#include "../timer/timer_game_economy.h"
+
+/**
+ * Replay of the commands and sync states that a server recorded in its
+ * desync log, so a session can be reproduced from one of the savegames
+ * it made. See docs/desync.md for how to record them.
+ */
+class CommandLogReplay {
+private:
+	/** A command or sync state of the log, to replay at a given moment. */
+	struct Entry {
+		TimerGameEconomy::Date date{}; ///< Date to replay the entry at.
+		uint32_t date_fract = 0; ///< Date fraction to replay the entry at.
+		std::optional<CommandPacket> command; ///< The command to execute, if the entry is not a sync state.
+		std::array<uint32_t, 2> sync_state{}; ///< The expected random state, if the entry is not a command.
+	};
+
+	std::vector<Entry> entries; ///< All entries of the log, in order.
+	size_t next = 0; ///< The next entry to replay.
+
+public:
+	size_t commands = 0; ///< Number of commands that were executed.
+	size_t skipped = 0; ///< Number of entries that were skipped, because the game was already past them.
+	size_t sync_checks = 0; ///< Number of sync states that matched.
+
+	bool Load(std::string_view filename);
+	bool Replay();
+
+	/**
+	 * Whether all entries of the log have been replayed.
+	 * @return True iff there is nothing left to replay.
+	 */
+	bool IsFinished() const { return this->next == this->entries.size(); }
+};
+
+#endif /* NETWORK_REPLAY_H */
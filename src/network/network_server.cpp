@@ -30,6 +30,7 @@
 #include "../core/random_func.hpp"
 #include "../company_cmd.h"
 #include "../rev.h"
+#include "../thread.h"
 #include "../timer/timer.h"
 #include "../timer/timer_game_calendar.h"
 #include "../timer/timer_game_economy.h"
@@ -647,6 +648,12 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::SendSync()
 #ifdef NETWORK_SEND_DOUBLE_SEED
 	p->Send_uint32(_sync_seed_2);
 #endif
+
+	if (_sync_state_hash.has_value()) {
+		p->Send_uint8(SHP_END);
+		for (uint32_t hash : *_sync_state_hash) p->Send_uint32(hash);
+	}
+
 	this->SendPacket(std::move(p));
 	return NETWORK_RECV_STATUS_OKAY;
 }
@@ -1672,6 +1679,104 @@ static void NetworkHandleCommandQueue(NetworkClientSocket *cs)
 	cs->outgoing_queue.clear();
 }
 
+/**
+ * Thread of dedicated servers that sends the queued packets of the clients
+ * while the game thread is busy running a tick. Handling the packets changes
+ * the game state, so that is left to the game thread, but this way a slow
+ * tick does not hold back the map downloads and other traffic to the clients.
+ */
+class NetworkBackgroundSender {
+private:
+	std::thread thread; ///< The thread sending the packets.
+	std::mutex mutex; ///< Held by the thread while sending, and guarding the state below.
+	std::condition_variable cv; ///< Signalled when the state below changes.
+	bool sending = false; ///< Whether the game thread is running a tick, so the packets may be sent.
+	bool stop = false; ///< Whether the thread must stop.
+
+	/** Send the packets whenever allowed, until told to stop. */
+	void Run()
+	{
+		std::unique_lock<std::mutex> lock(this->mutex);
+		while (true) {
+			this->cv.wait(lock, [this] { return this->sending || this->stop; });
+			if (this->stop) return;
+
+			/* The clients are neither created nor destroyed while the game thread runs a tick. */
+			for (NetworkClientSocket *cs : NetworkClientSocket::Iterate()) {
+				cs->SendPacketsInBackground();
+			}
+
+			/* Give the sockets some time to accept more data. */
+			this->cv.wait_for(lock, std::chrono::milliseconds(1), [this] { return !this->sending || this->stop; });
+		}
+	}
+
+	static void ThreadThunk(NetworkBackgroundSender *sender)
+	{
+		sender->Run();
+	}
+
+public:
+	~NetworkBackgroundSender()
+	{
+		this->Stop();
+	}
+
+	/** Allow sending in the background, starting the thread if needed. */
+	void Begin()
+	{
+		if (!_network_dedicated) return;
+		if (!this->thread.joinable() && !StartNewThread(&this->thread, "ottd:network", &NetworkBackgroundSender::ThreadThunk, this)) return;
+
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+			this->sending = true;
+		}
+		this->cv.notify_one();
+	}
+
+	/** Disallow sending in the background, waiting for the thread to finish the sending it is busy with. */
+	void End()
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->sending = false;
+	}
+
+	/** Stop the thread. */
+	void Stop()
+	{
+		if (!this->thread.joinable()) return;
+
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+			this->stop = true;
+		}
+		this->cv.notify_one();
+		this->thread.join();
+		this->stop = false;
+	}
+};
+
+static NetworkBackgroundSender _network_background_sender; ///< The sender of packets while the game thread runs a tick.
+
+/** Start sending the queued packets of the clients in the background, as the game thread is about to run a tick. */
+void NetworkServerBeginBackgroundSend()
+{
+	_network_background_sender.Begin();
+}
+
+/** Stop sending the queued packets of the clients in the background, as the game thread is done with the tick. */
+void NetworkServerEndBackgroundSend()
+{
+	_network_background_sender.End();
+}
+
+/** Stop the thread sending the queued packets of the clients in the background. */
+void NetworkServerStopBackgroundSend()
+{
+	_network_background_sender.Stop();
+}
+
 /**
  * This is called every tick if this is a _network_server
  * @param send_frame Whether to send the frame to the clients.
@@ -1687,6 +1792,10 @@ void NetworkServer_Tick(bool send_frame)
 		_last_sync_frame = _frame_counter;
 		send_sync = true;
 	}
+
+	/* All clients are sent the same hashes of the frame that was just made, so calculate them once here.
+	 * The sync sent when a client joins is not made at the end of a frame, so it is sent without them. */
+	if (send_sync && _settings_client.network.sync_state_hash) _sync_state_hash = CalculateStateHash();
 #endif
 
 	/* Now we are done with the frame, inform the clients that they can
@@ -1807,6 +1916,10 @@ void NetworkServer_Tick(bool send_frame)
 #endif
 		}
 	}
+
+#ifndef ENABLE_NETWORK_SYNC_EVERY_FRAME
+	_sync_state_hash.reset();
+#endif
 }
 
 /** Helper function to restart the map. */
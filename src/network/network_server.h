@@ -122,6 +122,9 @@ public:
 };
 
 void NetworkServer_Tick(bool send_frame);
+void NetworkServerBeginBackgroundSend();
+void NetworkServerEndBackgroundSend();
+void NetworkServerStopBackgroundSend();
 void ChangeNetworkRestartTime(bool reset);
 
 #endif /* NETWORK_SERVER_H */
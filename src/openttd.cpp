@@ -1223,16 +1223,22 @@ void StateGameLoop()
 		PerformanceMeasurer::Paused(PFE_GL_SHIPS);
 		PerformanceMeasurer::Paused(PFE_GL_AIRCRAFT);
 		PerformanceMeasurer::Paused(PFE_GL_LANDSCAPE);
+		PerformanceMeasurer::Paused(PFE_GL_TILELOOP);
+		PerformanceMeasurer::Paused(PFE_GL_ANIMATION);
+		PerformanceMeasurer::Paused(PFE_GL_TOWNS);
+		PerformanceMeasurer::Paused(PFE_GL_STATIONS);
+		PerformanceMeasurer::Paused(PFE_GL_INDUSTRIES);
+		PerformanceMeasurer::Paused(PFE_GL_TIMERS);
+		PerformanceMeasurer::Paused(PFE_GL_DAYPROCS);
 
 		if (!HasModalProgress()) UpdateLandscapingLimits();
-#ifndef DEBUG_DUMP_COMMANDS
-		if (_game_mode == GM_NORMAL) Game::GameLoop();
-#endif
+		if (_game_mode == GM_NORMAL && !_network_replaying_commands) Game::GameLoop();
 		return;
 	}
 
 	PerformanceMeasurer framerate(PFE_GAMELOOP);
 	PerformanceAccumulator::Reset(PFE_GL_LANDSCAPE);
+	PerformanceAccumulator::Reset(PFE_GL_DAYPROCS);
 
 	if (_game_mode == GM_EDITOR) {
 		BasePersistentStorageArray::SwitchMode(PSM_ENTER_GAMELOOP);
@@ -1259,23 +1265,25 @@ void StateGameLoop()
 
 		BasePersistentStorageArray::SwitchMode(PSM_ENTER_GAMELOOP);
 		AnimateAnimatedTiles();
-		if (TimerManager<TimerGameCalendar>::Elapsed(1)) {
-			RunVehicleCalendarDayProc();
+		{
+			PerformanceMeasurer timers_framerate(PFE_GL_TIMERS);
+			if (TimerManager<TimerGameCalendar>::Elapsed(1)) {
+				RunVehicleCalendarDayProc();
+			}
+			TimerManager<TimerGameEconomy>::Elapsed(1);
+			TimerManager<TimerGameTick>::Elapsed(1);
 		}
-		TimerManager<TimerGameEconomy>::Elapsed(1);
-		TimerManager<TimerGameTick>::Elapsed(1);
 		RunTileLoop();
 		CallVehicleTicks();
 		CallLandscapeTick();
 		BasePersistentStorageArray::SwitchMode(PSM_LEAVE_GAMELOOP);
 
-#ifndef DEBUG_DUMP_COMMANDS
-		{
+		if (!_network_replaying_commands) {
+			/* When replaying, the commands of scripts are replayed as well. */
 			PerformanceMeasurer script_framerate(PFE_ALLSCRIPTS);
 			AI::GameLoop();
 			Game::GameLoop();
 		}
-#endif
 		UpdateLandscapingLimits();
 
 		CallWindowGameTickEvent();
@@ -224,6 +224,8 @@ public:
 
 TypedIndexContainer<std::vector<WaterRegionData>, WaterRegionIndex> _water_region_data;
 TypedIndexContainer<std::vector<bool>, WaterRegionIndex> _is_water_region_valid;
+TypedIndexContainer<std::vector<uint32_t>, WaterRegionIndex> _water_region_last_change; ///< Generation at which each water region was last invalidated.
+static uint32_t _water_region_generation = 0; ///< Increased whenever any water region is invalidated.
 
 static TileIndex GetTileIndexFromLocalCoordinate(int region_x, int region_y, int local_x, int local_y)
 {
@@ -319,6 +321,7 @@ void InvalidateWaterRegion(TileIndex tile)
 		const WaterRegionIndex water_region_index = GetWaterRegionIndex(tile);
 		if (!_is_water_region_valid[water_region_index]) Debug(map, 3, "Invalidated water region ({},{})", GetWaterRegionX(tile), GetWaterRegionY(tile));
 		_is_water_region_valid[water_region_index] = false;
+		_water_region_last_change[water_region_index] = ++_water_region_generation;
 	};
 
 	invalidate_region(tile);
@@ -333,6 +336,28 @@ void InvalidateWaterRegion(TileIndex tile)
 	}
 }
 
+/**
+ * Get the current water region generation. It is increased whenever any water
+ * region is invalidated, so information derived from water regions that was
+ * gathered at this generation is still valid as long as it does not change.
+ * @return The current water region generation.
+ */
+uint32_t GetWaterRegionGeneration()
+{
+	return _water_region_generation;
+}
+
+/**
+ * Get the water region generation at which a water region was last invalidated.
+ * @param water_region The water region to check.
+ * @return The generation of the last change, or \c UINT32_MAX for water regions outside of the map.
+ */
+uint32_t GetWaterRegionLastChange(const WaterRegionDesc &water_region)
+{
+	if (water_region.x < 0 || water_region.y < 0 || water_region.x >= GetWaterRegionMapSizeX() || water_region.y >= GetWaterRegionMapSizeY()) return UINT32_MAX;
+	return _water_region_last_change[GetWaterRegionIndex(water_region)];
+}
+
 /**
  * Calls the provided callback function for all water region patches
  * accessible from one particular side of the starting patch.
@@ -422,6 +447,10 @@ void AllocateWaterRegions()
 	_is_water_region_valid.clear();
 	_is_water_region_valid.resize(number_of_regions, false);
 
+	/* All water regions are new, so anything derived from the old ones is invalid. */
+	_water_region_last_change.clear();
+	_water_region_last_change.resize(number_of_regions, ++_water_region_generation);
+
 	Debug(map, 2, "Allocating {} x {} water regions", GetWaterRegionMapSizeX(), GetWaterRegionMapSizeY());
 	assert(_is_water_region_valid.size() == _water_region_data.size());
 }
@@ -57,6 +57,9 @@ WaterRegionPatchDesc GetWaterRegionPatchInfo(TileIndex tile);
 
 void InvalidateWaterRegion(TileIndex tile);
 
+uint32_t GetWaterRegionGeneration();
+uint32_t GetWaterRegionLastChange(const WaterRegionDesc &water_region);
+
 using VisitWaterRegionPatchCallback = std::function<void(const WaterRegionPatchDesc &)>;
 void VisitWaterRegionPatchNeighbours(const WaterRegionPatchDesc &water_region_patch, VisitWaterRegionPatchCallback &callback);
 
@@ -5,287 +5,240 @@
  * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
  */
 
- /** @file yapf_ship_regions.cpp Implementation of YAPF for water regions, which are used for finding intermediate ship destinations. */
+ /** @file yapf_ship_regions.cpp Implementation of flow fields for water regions, which are used for finding intermediate ship destinations. */
 
 #include "../../stdafx.h"
 #include "../../ship.h"
+#include "../../base_station_base.h"
 
-#include "yapf.hpp"
 #include "yapf_ship_regions.h"
 #include "../water_regions.h"
 
+#include <queue>
+
 #include "../../safeguards.h"
 
 constexpr int DIRECT_NEIGHBOUR_COST = 100;
 constexpr int NODES_PER_REGION = 4;
 constexpr int MAX_NUMBER_OF_NODES = 65536;
+constexpr size_t MAX_NUMBER_OF_FLOW_FIELDS = 64;
+constexpr size_t MAX_NUMBER_OF_FLOW_FIELD_NODES = 4 * MAX_NUMBER_OF_NODES; ///< Number of nodes of all flow fields together above which the least recently used ones are dropped.
 
-/** Yapf Node Key that represents a single patch of interconnected water within a water region. */
-struct CYapfRegionPatchNodeKey {
-	WaterRegionPatchDesc water_region_patch;
-
-	inline void Set(const WaterRegionPatchDesc &water_region_patch)
-	{
-		this->water_region_patch = water_region_patch;
-	}
-
-	inline int CalcHash() const { return CalculateWaterRegionPatchHash(this->water_region_patch); }
-	inline bool operator==(const CYapfRegionPatchNodeKey &other) const { return this->CalcHash() == other.CalcHash(); }
-};
-
-inline uint ManhattanDistance(const CYapfRegionPatchNodeKey &a, const CYapfRegionPatchNodeKey &b)
+inline int ManhattanDistance(const WaterRegionPatchDesc &a, const WaterRegionPatchDesc &b)
 {
-	return (std::abs(a.water_region_patch.x - b.water_region_patch.x) + std::abs(a.water_region_patch.y - b.water_region_patch.y)) * DIRECT_NEIGHBOUR_COST;
+	return (std::abs(a.x - b.x) + std::abs(a.y - b.y)) * DIRECT_NEIGHBOUR_COST;
 }
 
-/** Yapf Node for water regions. */
-template <class Tkey_>
-struct CYapfRegionNodeT : CYapfNodeT<Tkey_, CYapfRegionNodeT<Tkey_> > {
-	typedef Tkey_ Key;
-	typedef CYapfRegionNodeT<Tkey_> Node;
-
-	inline void Set(Node *parent, const WaterRegionPatchDesc &water_region_patch)
-	{
-		this->key.Set(water_region_patch);
-		this->hash_next = nullptr;
-		this->parent = parent;
-		this->cost = 0;
-		this->estimate = 0;
-	}
-
-	inline void Set(Node *parent, const Key &key)
-	{
-		this->Set(parent, key.water_region_patch);
-	}
-
-	DiagDirection GetDiagDirFromParent() const
-	{
-		if (this->parent == nullptr) return INVALID_DIAGDIR;
-		const int dx = this->key.water_region_patch.x - this->parent->key.water_region_patch.x;
-		const int dy = this->key.water_region_patch.y - this->parent->key.water_region_patch.y;
-		if (dx > 0 && dy == 0) return DIAGDIR_SW;
-		if (dx < 0 && dy == 0) return DIAGDIR_NE;
-		if (dx == 0 && dy > 0) return DIAGDIR_SE;
-		if (dx == 0 && dy < 0) return DIAGDIR_NW;
-		return INVALID_DIAGDIR;
-	}
-};
-
-/** YAPF origin for water regions. */
-template <class Types>
-class CYapfOriginRegionT
+/**
+ * Get the direction from one water region patch to an adjacent one.
+ * @param from The patch to move from.
+ * @param to The patch to move to.
+ * @return The direction, or \c INVALID_DIAGDIR if the patches are not directly adjacent, e.g. when connected by an aqueduct.
+ */
+static DiagDirection GetDiagDirBetween(const WaterRegionPatchDesc &from, const WaterRegionPatchDesc &to)
 {
-public:
-	typedef typename Types::Tpf Tpf; ///< The pathfinder class (derived from THIS class).
-	typedef typename Types::NodeList::Item Node; ///< This will be our node type.
-	typedef typename Node::Key Key; ///< Key to hash tables.
+	const int dx = to.x - from.x;
+	const int dy = to.y - from.y;
+	if (dx == 1 && dy == 0) return DIAGDIR_SW;
+	if (dx == -1 && dy == 0) return DIAGDIR_NE;
+	if (dx == 0 && dy == 1) return DIAGDIR_SE;
+	if (dx == 0 && dy == -1) return DIAGDIR_NW;
+	return INVALID_DIAGDIR;
+}
 
-protected:
-	inline Tpf &Yapf() { return *static_cast<Tpf*>(this); }
+/**
+ * Distances from a set of destination water region patches to the water
+ * region patches ships are heading there from. Ships heading to the same
+ * destination share the field, and only need to follow the decreasing
+ * distances instead of searching a path each.
+ *
+ * The field is built with a Dijkstra search starting from the destination
+ * patches, which is only continued as far as needed to reach the patches of
+ * the ships using it. Like the search of a single path, it gives up after
+ * a maximum number of nodes; ships further away are lost.
+ */
+struct WaterRegionFlowField {
+	/** Patch waiting to be visited by the search. */
+	struct QueueItem {
+		int distance;
+		int hash;
+		WaterRegionPatchDesc water_region_patch;
+
+		bool operator>(const QueueItem &other) const { return std::tie(this->distance, this->hash) > std::tie(other.distance, other.hash); }
+	};
+
+	std::vector<int> origins; ///< Sorted hashes of the destination patches.
+	std::unordered_map<int, int> distances; ///< Distance to the nearest destination patch, per patch hash; final for visited patches.
+	std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<>> queue; ///< Patches still to be visited.
+	int visited_nodes = 0; ///< Number of patches visited so far.
+	std::vector<WaterRegionDesc> regions; ///< The water regions that were read to build the field.
+	std::vector<bool> seen_regions; ///< Per water region whether it is in #regions.
+	uint32_t generation = 0; ///< Water region generation at which the field is known to be valid.
+	uint64_t last_used = 0; ///< Moment of the last use, to evict the least recently used field.
+
+	bool IsValid() const;
+	void Reset(const std::vector<WaterRegionPatchDesc> &origin_patches);
+	bool Expand(const WaterRegionPatchDesc &target, int max_nodes);
+	int GetDistance(const WaterRegionPatchDesc &water_region_patch) const;
 
 private:
-	std::vector<CYapfRegionPatchNodeKey> origin_keys;
-
-public:
-	void AddOrigin(const WaterRegionPatchDesc &water_region_patch)
-	{
-		if (water_region_patch.label == INVALID_WATER_REGION_PATCH) return;
-		if (!HasOrigin(water_region_patch)) this->origin_keys.emplace_back(water_region_patch);
-	}
-
-	bool HasOrigin(const WaterRegionPatchDesc &water_region_patch)
-	{
-		return std::ranges::find(this->origin_keys, CYapfRegionPatchNodeKey{ water_region_patch }) != this->origin_keys.end();
-	}
-
-	void PfSetStartupNodes()
-	{
-		for (const CYapfRegionPatchNodeKey &origin_key : this->origin_keys) {
-			Node &node = Yapf().CreateNewNode();
-			node.Set(nullptr, origin_key);
-			Yapf().AddStartupNode(node);
-		}
-	}
+	void AddRegion(int x, int y);
 };
 
-/** YAPF destination provider for water regions. */
-template <class Types>
-class CYapfDestinationRegionT
+/**
+ * Check whether the field is still valid, i.e. none of the water regions it was built from changed since.
+ * The result of building a field only depends on those water regions, so it is exactly as if it were rebuilt.
+ * @return True iff the field can still be used.
+ */
+bool WaterRegionFlowField::IsValid() const
 {
-public:
-	typedef typename Types::Tpf Tpf; ///< The pathfinder class (derived from THIS class).
-	typedef typename Types::NodeList::Item Node; ///< This will be our node type.
-	typedef typename Node::Key Key; ///< Key to hash tables.
-
-protected:
-	Key dest;
-
-public:
-	void SetDestination(const WaterRegionPatchDesc &water_region_patch)
-	{
-		this->dest.Set(water_region_patch);
-	}
-
-protected:
-	Tpf &Yapf() { return *static_cast<Tpf*>(this); }
-
-public:
-	inline bool PfDetectDestination(Node &n) const
-	{
-		return n.key == this->dest;
-	}
-
-	inline bool PfCalcEstimate(Node &n)
-	{
-		if (this->PfDetectDestination(n)) {
-			n.estimate = n.cost;
-			return true;
-		}
-
-		n.estimate = n.cost + ManhattanDistance(n.key, this->dest);
+	return std::ranges::none_of(this->regions, [this](const WaterRegionDesc &region) { return GetWaterRegionLastChange(region) > this->generation; });
+}
 
-		return true;
+/**
+ * Start the field anew from the destination patches.
+ * @param origin_patches The destination patches of the field.
+ */
+void WaterRegionFlowField::Reset(const std::vector<WaterRegionPatchDesc> &origin_patches)
+{
+	this->distances.clear();
+	this->queue = {};
+	this->visited_nodes = 0;
+	this->regions.clear();
+	this->seen_regions.assign((Map::SizeX() / WATER_REGION_EDGE_LENGTH) * (Map::SizeY() / WATER_REGION_EDGE_LENGTH), false);
+	this->generation = GetWaterRegionGeneration();
+
+	for (const WaterRegionPatchDesc &origin : origin_patches) {
+		const int hash = CalculateWaterRegionPatchHash(origin);
+		this->distances[hash] = 0;
+		this->queue.emplace(0, hash, origin);
+		this->AddRegion(origin.x, origin.y);
 	}
-};
+}
 
-/** YAPF node following for water region pathfinding. */
-template <class Types>
-class CYapfFollowRegionT
+/**
+ * Remember that a water region is read while building the field.
+ * @param x The X coordinate of the water region.
+ * @param y The Y coordinate of the water region.
+ */
+void WaterRegionFlowField::AddRegion(int x, int y)
 {
-public:
-	typedef typename Types::Tpf Tpf; ///< The pathfinder class (derived from THIS class).
-	typedef typename Types::TrackFollower TrackFollower;
-	typedef typename Types::NodeList::Item Node; ///< This will be our node type.
-	typedef typename Node::Key Key; ///< Key to hash tables.
-
-protected:
-	inline Tpf &Yapf() { return *static_cast<Tpf*>(this); }
-
-public:
-	inline void PfFollowNode(Node &old_node)
-	{
-		VisitWaterRegionPatchCallback visit_func = [&](const WaterRegionPatchDesc &water_region_patch)
-		{
-			Node &node = Yapf().CreateNewNode();
-			node.Set(&old_node, water_region_patch);
-			Yapf().AddNewNode(node, TrackFollower{});
-		};
-		VisitWaterRegionPatchNeighbours(old_node.key.water_region_patch, visit_func);
-	}
+	const int region_map_size_x = Map::SizeX() / WATER_REGION_EDGE_LENGTH;
+	const int region_map_size_y = Map::SizeY() / WATER_REGION_EDGE_LENGTH;
+	if (x < 0 || y < 0 || x >= region_map_size_x || y >= region_map_size_y) return;
+	if (this->seen_regions[y * region_map_size_x + x]) return;
+	this->seen_regions[y * region_map_size_x + x] = true;
+	this->regions.emplace_back(x, y);
+}
 
-	inline char TransportTypeChar() const { return '^'; }
-
-	static std::vector<WaterRegionPatchDesc> FindWaterRegionPath(const Ship *v, TileIndex start_tile, int max_returned_path_length)
-	{
-		const WaterRegionPatchDesc start_water_region_patch = GetWaterRegionPatchInfo(start_tile);
-
-		/* We reserve 4 nodes (patches) per water region. The vast majority of water regions have 1 or 2 regions so this should be a pretty
-		 * safe limit. We cap the limit at 65536 which is at a region size of 16x16 is equivalent to one node per region for a 4096x4096 map. */
-		Tpf pf(std::min(static_cast<int>(Map::Size() * NODES_PER_REGION) / WATER_REGION_NUMBER_OF_TILES, MAX_NUMBER_OF_NODES));
-		pf.SetDestination(start_water_region_patch);
-
-		if (v->current_order.IsType(OT_GOTO_STATION)) {
-			StationID station_id = v->current_order.GetDestination().ToStationID();
-			const BaseStation *station = BaseStation::Get(station_id);
-			TileArea tile_area;
-			station->GetTileArea(&tile_area, StationType::Dock);
-			for (const auto &tile : tile_area) {
-				if (IsDockingTile(tile) && IsShipDestinationTile(tile, station_id)) {
-					pf.AddOrigin(GetWaterRegionPatchInfo(tile));
-				}
-			}
-		} else {
-			TileIndex tile = v->dest_tile;
-			pf.AddOrigin(GetWaterRegionPatchInfo(tile));
+/**
+ * Continue the search until the distance of the given patch is final.
+ * Patches are visited in a fixed order, so whether the patch is reached within
+ * the maximum number of nodes does not depend on earlier uses of the field.
+ * @param target The patch to get the distance of.
+ * @param max_nodes The maximum number of patches to visit.
+ * @return True iff the distance of the patch is known.
+ */
+bool WaterRegionFlowField::Expand(const WaterRegionPatchDesc &target, int max_nodes)
+{
+	const int target_hash = CalculateWaterRegionPatchHash(target);
+
+	while (!this->queue.empty()) {
+		/* Once all patches up to its distance are visited, the distance of the target can not get shorter. */
+		auto found = this->distances.find(target_hash);
+		if (found != this->distances.end() && this->queue.top().distance > found->second) return true;
+
+		const QueueItem item = this->queue.top();
+		if (this->distances[item.hash] != item.distance) {
+			/* Already reached with a shorter distance. */
+			this->queue.pop();
+			continue;
 		}
-
-		/* If origin and destination are the same we simply return that water patch. */
-		std::vector<WaterRegionPatchDesc> path = { start_water_region_patch };
-		path.reserve(max_returned_path_length);
-		if (pf.HasOrigin(start_water_region_patch)) return path;
-
-		/* Find best path. */
-		if (!pf.FindPath(v)) return {}; // Path not found.
-
-		Node *node = pf.GetBestNode();
-		for (int i = 0; i < max_returned_path_length - 1; ++i) {
-			if (node != nullptr) {
-				node = node->parent;
-				if (node != nullptr) path.push_back(node->key.water_region_patch);
-			}
+		if (this->visited_nodes >= max_nodes) return false;
+		this->queue.pop();
+		this->visited_nodes++;
+
+		/* Remember each water region that is read while visiting neighbours, i.e. the visited ones, all regions next to
+		 * them and the regions of all discovered patches, which can be further away at the end of an aqueduct. */
+		const WaterRegionPatchDesc &current = item.water_region_patch;
+		this->AddRegion(current.x, current.y);
+		for (DiagDirection side = DIAGDIR_BEGIN; side < DIAGDIR_END; side++) {
+			const TileIndexDiffC offset = TileIndexDiffCByDiagDir(side);
+			this->AddRegion(current.x + offset.x, current.y + offset.y);
 		}
 
-		assert(!path.empty());
-		return path;
+		VisitWaterRegionPatchCallback visit_func = [&](const WaterRegionPatchDesc &water_region_patch) {
+			this->AddRegion(water_region_patch.x, water_region_patch.y);
+			const int hash = CalculateWaterRegionPatchHash(water_region_patch);
+			const int distance = item.distance + ManhattanDistance(current, water_region_patch);
+			auto [it, inserted] = this->distances.try_emplace(hash, distance);
+			if (!inserted) {
+				if (it->second <= distance) return;
+				it->second = distance;
+			}
+			this->queue.emplace(distance, hash, water_region_patch);
+		};
+		VisitWaterRegionPatchNeighbours(current, visit_func);
 	}
-};
 
-/** Cost Provider of YAPF for water regions. */
-template <class Types>
-class CYapfCostRegionT
-{
-public:
-	typedef typename Types::Tpf Tpf; ///< The pathfinder class (derived from THIS class).
-	typedef typename Types::TrackFollower TrackFollower;
-	typedef typename Types::NodeList::Item Node; ///< This will be our node type.
-	typedef typename Node::Key Key; ///< Key to hash tables.
-
-protected:
-	/** To access inherited path finder. */
-	Tpf &Yapf() { return *static_cast<Tpf*>(this); }
-
-public:
-	/**
-	 * Called by YAPF to calculate the cost from the origin to the given node.
-	 * Calculates only the cost of given node, adds it to the parent node cost
-	 * and stores the result into Node::cost member.
-	 */
-	inline bool PfCalcCost(Node &n, const TrackFollower *)
-	{
-		n.cost = n.parent->cost + ManhattanDistance(n.key, n.parent->key);
-
-		/* Incentivise zigzagging by adding a slight penalty when the search continues in the same direction. */
-		Node *grandparent = n.parent->parent;
-		if (grandparent != nullptr) {
-			const DiagDirDiff dir_diff = DiagDirDifference(n.parent->GetDiagDirFromParent(), n.GetDiagDirFromParent());
-			if (dir_diff != DIAGDIRDIFF_90LEFT && dir_diff != DIAGDIRDIFF_90RIGHT) n.cost += 1;
-		}
+	return this->distances.contains(target_hash);
+}
 
-		return true;
-	}
-};
+/**
+ * Get the distance from a water region patch to the nearest destination of the field.
+ * @param water_region_patch The patch to get the distance for.
+ * @return The distance, or -1 if no destination can be reached from the patch.
+ */
+int WaterRegionFlowField::GetDistance(const WaterRegionPatchDesc &water_region_patch) const
+{
+	auto it = this->distances.find(CalculateWaterRegionPatchHash(water_region_patch));
+	return it == this->distances.end() ? -1 : it->second;
+}
 
-/* We don't need a follower but YAPF requires one. */
-struct DummyFollower : public CFollowTrackWater {};
+static std::vector<WaterRegionFlowField> _water_region_flow_fields; ///< Flow fields to recently used destinations.
+static uint64_t _water_region_flow_field_uses = 0; ///< Number of times a flow field was used, for eviction.
 
 /**
- * Config struct of YAPF for route planning.
- * Defines all 6 base YAPF modules as classes providing services for CYapfBaseT.
+ * Get an up to date flow field towards the given destination patches.
+ * @param origin_patches The destination patches.
+ * @return The flow field.
  */
-template <class Tpf_, class Tnode_list>
-struct CYapfRegion_TypesT
+static WaterRegionFlowField &GetWaterRegionFlowField(const std::vector<WaterRegionPatchDesc> &origin_patches)
 {
-	typedef CYapfRegion_TypesT<Tpf_, Tnode_list> Types;         ///< Shortcut for this struct type.
-	typedef Tpf_                                 Tpf;           ///< Pathfinder type.
-	typedef DummyFollower                        TrackFollower; ///< Track follower helper class
-	typedef Tnode_list                           NodeList;
-	typedef Ship                                 VehicleType;
-
-	/** Pathfinder components (modules). */
-	typedef CYapfBaseT<Types>                 PfBase;        ///< Base pathfinder class.
-	typedef CYapfFollowRegionT<Types>         PfFollow;      ///< Node follower.
-	typedef CYapfOriginRegionT<Types>         PfOrigin;      ///< Origin provider.
-	typedef CYapfDestinationRegionT<Types>    PfDestination; ///< Destination/distance provider.
-	typedef CYapfSegmentCostCacheNoneT<Types> PfCache;       ///< Segment cost cache provider.
-	typedef CYapfCostRegionT<Types>           PfCost;        ///< Cost provider.
-};
+	/* Bound the memory of the fields by dropping the least recently used ones. */
+	size_t total_nodes = 0;
+	for (const WaterRegionFlowField &field : _water_region_flow_fields) total_nodes += field.distances.size();
+	while (total_nodes > MAX_NUMBER_OF_FLOW_FIELD_NODES) {
+		auto lru = std::ranges::min_element(_water_region_flow_fields, std::less{}, &WaterRegionFlowField::last_used);
+		total_nodes -= lru->distances.size();
+		_water_region_flow_fields.erase(lru);
+	}
 
-typedef NodeList<CYapfRegionNodeT<CYapfRegionPatchNodeKey>, 12, 12> CRegionNodeListWater;
+	std::vector<int> origins;
+	origins.reserve(origin_patches.size());
+	for (const WaterRegionPatchDesc &origin : origin_patches) origins.push_back(CalculateWaterRegionPatchHash(origin));
+	std::ranges::sort(origins);
 
-struct CYapfRegionWater : CYapfT<CYapfRegion_TypesT<CYapfRegionWater, CRegionNodeListWater>>
-{
-	explicit CYapfRegionWater(int max_nodes) { this->max_search_nodes = max_nodes; }
-};
+	auto it = std::ranges::find(_water_region_flow_fields, origins, &WaterRegionFlowField::origins);
+	if (it == _water_region_flow_fields.end()) {
+		if (_water_region_flow_fields.size() < MAX_NUMBER_OF_FLOW_FIELDS) {
+			it = _water_region_flow_fields.emplace(_water_region_flow_fields.end());
+		} else {
+			it = std::ranges::min_element(_water_region_flow_fields, std::less{}, &WaterRegionFlowField::last_used);
+		}
+		it->origins = std::move(origins);
+		it->Reset(origin_patches);
+	} else if (it->generation != GetWaterRegionGeneration()) {
+		if (it->IsValid()) {
+			it->generation = GetWaterRegionGeneration();
+		} else {
+			it->Reset(origin_patches);
+		}
+	}
+
+	it->last_used = ++_water_region_flow_field_uses;
+	return *it;
+}
 
 /**
  * Finds a path at the water region level. Note that the starting region is always included if the path was found.
@@ -296,5 +249,64 @@ struct CYapfRegionWater : CYapfT<CYapfRegion_TypesT<CYapfRegionWater, CRegionNod
  */
 std::vector<WaterRegionPatchDesc> YapfShipFindWaterRegionPath(const Ship *v, TileIndex start_tile, int max_returned_path_length)
 {
-	return CYapfRegionWater::FindWaterRegionPath(v, start_tile, max_returned_path_length);
+	const WaterRegionPatchDesc start_water_region_patch = GetWaterRegionPatchInfo(start_tile);
+
+	std::vector<WaterRegionPatchDesc> origin_patches;
+	auto add_origin = [&origin_patches](const WaterRegionPatchDesc &water_region_patch) {
+		if (water_region_patch.label == INVALID_WATER_REGION_PATCH) return;
+		if (std::ranges::find(origin_patches, water_region_patch) == origin_patches.end()) origin_patches.push_back(water_region_patch);
+	};
+
+	if (v->current_order.IsType(OT_GOTO_STATION)) {
+		StationID station_id = v->current_order.GetDestination().ToStationID();
+		const BaseStation *station = BaseStation::Get(station_id);
+		TileArea tile_area;
+		station->GetTileArea(&tile_area, StationType::Dock);
+		for (const auto &tile : tile_area) {
+			if (IsDockingTile(tile) && IsShipDestinationTile(tile, station_id)) {
+				add_origin(GetWaterRegionPatchInfo(tile));
+			}
+		}
+	} else {
+		add_origin(GetWaterRegionPatchInfo(v->dest_tile));
+	}
+
+	/* If origin and destination are the same we simply return that water patch. */
+	std::vector<WaterRegionPatchDesc> path = { start_water_region_patch };
+	path.reserve(max_returned_path_length);
+	if (std::ranges::find(origin_patches, start_water_region_patch) != origin_patches.end()) return path;
+	if (origin_patches.empty()) return {}; // Path not found.
+
+	WaterRegionFlowField &field = GetWaterRegionFlowField(origin_patches);
+	const int max_nodes = std::min(static_cast<int>(Map::Size() * NODES_PER_REGION) / WATER_REGION_NUMBER_OF_TILES, MAX_NUMBER_OF_NODES);
+	if (!field.Expand(start_water_region_patch, max_nodes)) return {}; // Path not found.
+	int distance = field.GetDistance(start_water_region_patch);
+
+	/* Follow the decreasing distances. Of the equally short ways, prefer to change direction so ships zigzag towards their destination. */
+	DiagDirection last_dir = INVALID_DIAGDIR;
+	while (static_cast<int>(path.size()) < max_returned_path_length && distance > 0) {
+		const WaterRegionPatchDesc current = path.back();
+		std::optional<WaterRegionPatchDesc> best;
+		DiagDirection best_dir = INVALID_DIAGDIR;
+		int best_distance = 0;
+
+		VisitWaterRegionPatchCallback visit_func = [&](const WaterRegionPatchDesc &water_region_patch) {
+			const int next_distance = field.GetDistance(water_region_patch);
+			if (next_distance < 0 || next_distance + ManhattanDistance(current, water_region_patch) != distance) return;
+
+			const DiagDirection dir = GetDiagDirBetween(current, water_region_patch);
+			if (best.has_value() && (best_dir != last_dir || dir == last_dir)) return;
+			best = water_region_patch;
+			best_dir = dir;
+			best_distance = next_distance;
+		};
+		VisitWaterRegionPatchNeighbours(current, visit_func);
+
+		if (!best.has_value()) break;
+		path.push_back(*best);
+		distance = best_distance;
+		last_dir = best_dir;
+	}
+
+	return path;
 }
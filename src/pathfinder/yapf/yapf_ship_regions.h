@@ -5,7 +5,7 @@
  * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
  */
 
- /** @file yapf_ship_regions.h Implementation of YAPF for water regions, which are used for finding intermediate ship destinations. */
+ /** @file yapf_ship_regions.h Implementation of flow fields for water regions, which are used for finding intermediate ship destinations. */
 
 #ifndef YAPF_SHIP_REGIONS_H
 #define YAPF_SHIP_REGIONS_H
@@ -580,8 +580,8 @@ static bool RoadVehCheckTrainCrash(RoadVehicle *v)
 
 		if (!IsLevelCrossingTile(tile)) continue;
 
-		if (HasVehicleNearTileXY(v->x_pos, v->y_pos, 4, [&u](const Vehicle *t) {
-				return t->type == VEH_TRAIN && abs(t->z_pos - u->z_pos) <= 6;
+		if (HasVehicleNearTileXY(v->x_pos, v->y_pos, 4, VEH_TRAIN, [&u](const Vehicle *t) {
+				return abs(t->z_pos - u->z_pos) <= 6;
 			})) {
 			RoadVehCrash(v);
 			return true;
@@ -633,8 +633,9 @@ static void FindClosestBlockingRoadVeh(Vehicle *v, RoadVehFindData *rvf)
 	int x_diff = v->x_pos - rvf->x;
 	int y_diff = v->y_pos - rvf->y;
 
-	/* Not a close Road vehicle when it's not a road vehicle, in the depot, or ourself. */
-	if (v->type != VEH_ROAD || v->IsInDepot() || rvf->veh->First() == v->First()) return;
+	/* Not a close Road vehicle when it's in the depot, or ourself. */
+	assert(v->type == VEH_ROAD);
+	if (v->IsInDepot() || rvf->veh->First() == v->First()) return;
 
 	/* Not close when at a different height or when going in a different direction. */
 	if (abs(v->z_pos - rvf->veh->z_pos) >= 6 || v->direction != rvf->dir) return;
@@ -667,15 +668,16 @@ static RoadVehicle *RoadVehFindCloseTo(RoadVehicle *v, int x, int y, Direction d
 	rvf.veh = v;
 	rvf.best_diff = UINT_MAX;
 
+	/* Only road vehicles can block us, so skip all other vehicles sharing the hash. */
 	if (front->state == RVSB_WORMHOLE) {
-		for (Vehicle *u : VehiclesOnTile(v->tile)) {
+		for (Vehicle *u : VehiclesOnTile(v->tile, VEH_ROAD)) {
 			FindClosestBlockingRoadVeh(u, &rvf);
 		}
-		for (Vehicle *u : VehiclesOnTile(GetOtherTunnelBridgeEnd(v->tile))) {
+		for (Vehicle *u : VehiclesOnTile(GetOtherTunnelBridgeEnd(v->tile), VEH_ROAD)) {
 			FindClosestBlockingRoadVeh(u, &rvf);
 		}
 	} else {
-		for (Vehicle *u : VehiclesNearTileXY(x, y, 8)) {
+		for (Vehicle *u : VehiclesNearTileXY(x, y, 8, VEH_ROAD)) {
 			FindClosestBlockingRoadVeh(u, &rvf);
 		}
 	}
@@ -800,8 +802,8 @@ static bool CheckRoadBlockedForOvertaking(OvertakeData *od)
 	if (!HasBit(trackdirbits, od->trackdir) || (trackbits & ~TRACK_BIT_CROSS) || (red_signals != TRACKDIR_BIT_NONE)) return true;
 
 	/* Are there more vehicles on the tile except the two vehicles involved in overtaking */
-	return HasVehicleOnTile(od->tile, [&](const Vehicle *v) {
-		return v->type == VEH_ROAD && v->First() == v && v != od->u && v != od->v;
+	return HasVehicleOnTile(od->tile, VEH_ROAD, [&](const Vehicle *v) {
+		return v->First() == v && v != od->u && v != od->v;
 	});
 }
 
@@ -1607,6 +1609,8 @@ static bool RoadVehController(RoadVehicle *v)
 
 	int adv_spd = v->GetAdvanceDistance();
 	bool blocked = false;
+	/* Update the viewport only once after all movement steps. */
+	_vehicle_viewport_update_batch = v;
 	while (j >= adv_spd) {
 		j -= adv_spd;
 
@@ -1625,13 +1629,12 @@ static bool RoadVehController(RoadVehicle *v)
 		/* Test for a collision, but only if another movement will occur. */
 		if (j >= adv_spd && RoadVehCheckTrainCrash(v)) break;
 	}
+	_vehicle_viewport_update_batch = nullptr;
 
 	v->SetLastSpeed();
 
 	for (RoadVehicle *u = v; u != nullptr; u = u->Next()) {
-		if (u->vehstatus.Test(VehState::Hidden)) continue;
-
-		u->UpdateViewport(false, false);
+		u->UpdateViewportAfterMovement();
 	}
 
 	/* If movement is blocked, set 'progress' to its maximum, so the roadvehicle does
@@ -0,0 +1,320 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file sampling_profiler.cpp Implementation of the built-in sampling profiler.
+ *
+ * The profiler uses a profiling timer signal to interrupt the process at a regular interval of
+ * CPU time, and captures the stack of the interrupted thread in the signal handler. The stack is
+ * captured by following the chain of frame pointers, as unwinders like backtrace() are not
+ * async-signal-safe; frames of code built without frame pointers are therefore missing. The signal
+ * handler only writes the stack into a preallocated buffer; the main thread regularly moves the
+ * samples from that buffer into a map of distinct stacks. When the profiler is stopped, the stacks
+ * are written in the "folded" format, which can be turned into a flame graph by most tools.
+ */
+
+#include "stdafx.h"
+#include "sampling_profiler.h"
+#include "fileio_func.h"
+#include "core/format.hpp"
+#include "timer/timer.h"
+#include "timer/timer_game_realtime.h"
+
+#if defined(__GLIBC__) && (defined(__x86_64__) || defined(__i386__) || defined(__aarch64__))
+#	define WITH_SAMPLING_PROFILER
+#	include <dlfcn.h>
+#	include <pthread.h>
+#	include <signal.h>
+#	include <ucontext.h>
+#	include <sys/time.h>
+#	include <cxxabi.h>
+#	include <cerrno>
+#endif
+
+#include <atomic>
+
+#include "safeguards.h"
+
+#if defined(WITH_SAMPLING_PROFILER)
+
+static constexpr int MAX_SAMPLE_DEPTH = 64; ///< Maximum number of frames of a sampled stack.
+static constexpr size_t NUM_SAMPLE_SLOTS = 4096; ///< Number of samples that can be waiting to be processed.
+
+/** A stack sampled by the signal handler. */
+struct Sample {
+	std::atomic<bool> ready{false}; ///< Whether the sample is written and waits to be processed.
+	int depth = 0; ///< Number of frames in the sample.
+	std::array<void *, MAX_SAMPLE_DEPTH> frames{}; ///< Return addresses of the frames, innermost first.
+};
+
+/* The buffer is never freed, as a signal might still be handled on another thread while stopping. */
+static std::unique_ptr<Sample[]> _samples; ///< Buffer of samples waiting to be processed.
+static std::atomic<size_t> _sample_next{0}; ///< Counter to pick the slot of the next sample.
+static std::atomic<uint64_t> _samples_taken{0}; ///< Number of samples written into the buffer.
+static std::atomic<uint64_t> _samples_dropped{0}; ///< Number of samples lost as their slot was still in use.
+static std::atomic<bool> _profiler_active{false}; ///< Whether the profiler is running.
+static std::map<std::vector<void *>, uint64_t> _profile_stacks; ///< Number of samples of each distinct stack, innermost frame first.
+
+static thread_local uintptr_t _thread_stack_low = 0; ///< Lowest address of the stack of the current thread, or 0 when unknown.
+static thread_local uintptr_t _thread_stack_high = 0; ///< Address just past the stack of the current thread, or 0 when unknown.
+
+/**
+ * Walk the chain of frame pointers of the interrupted code.
+ * Every frame starts with the frame pointer of its caller, followed by the return address.
+ * Only frames within the stack of the current thread are followed, so a function that uses
+ * the frame pointer register for something else cannot make us read arbitrary memory.
+ * @param context The machine context of the interrupted code.
+ * @param[out] frames The return addresses, innermost first.
+ * @return The number of frames written.
+ */
+static int WalkFramePointers(const ucontext_t *context, std::span<void *> frames)
+{
+#if defined(__x86_64__)
+	uintptr_t pc = context->uc_mcontext.gregs[REG_RIP];
+	uintptr_t fp = context->uc_mcontext.gregs[REG_RBP];
+#elif defined(__i386__)
+	uintptr_t pc = context->uc_mcontext.gregs[REG_EIP];
+	uintptr_t fp = context->uc_mcontext.gregs[REG_EBP];
+#elif defined(__aarch64__)
+	uintptr_t pc = context->uc_mcontext.pc;
+	uintptr_t fp = context->uc_mcontext.regs[29];
+#endif
+
+	int depth = 0;
+	frames[depth++] = reinterpret_cast<void *>(pc);
+
+	/* Without the bounds of the stack we cannot tell whether a frame pointer is valid. */
+	if (_thread_stack_high == 0) return depth;
+
+	while (depth < static_cast<int>(frames.size())) {
+		if (fp < _thread_stack_low || fp > _thread_stack_high - 2 * sizeof(uintptr_t) || fp % alignof(uintptr_t) != 0) break;
+
+		const uintptr_t *frame = reinterpret_cast<const uintptr_t *>(fp);
+		uintptr_t caller_fp = frame[0];
+		uintptr_t return_address = frame[1];
+		if (return_address == 0) break;
+		frames[depth++] = reinterpret_cast<void *>(return_address);
+
+		/* The stack grows downwards, so the frame of the caller must be at a higher address. */
+		if (caller_fp <= fp) break;
+		fp = caller_fp;
+	}
+	return depth;
+}
+
+/**
+ * Handler of the profiling timer signal; captures the stack of the interrupted thread.
+ * Only async-signal-safe operations are allowed here.
+ * @param context The machine context of the interrupted code.
+ */
+static void SamplingProfilerSignalHandler(int, siginfo_t *, void *context)
+{
+	if (!_profiler_active.load(std::memory_order_relaxed)) return;
+
+	int saved_errno = errno;
+	Sample &sample = _samples[_sample_next.fetch_add(1, std::memory_order_relaxed) % NUM_SAMPLE_SLOTS];
+	if (sample.ready.load(std::memory_order_acquire)) {
+		_samples_dropped.fetch_add(1, std::memory_order_relaxed);
+	} else {
+		sample.depth = WalkFramePointers(static_cast<const ucontext_t *>(context), sample.frames);
+		sample.ready.store(true, std::memory_order_release);
+		_samples_taken.fetch_add(1, std::memory_order_relaxed);
+	}
+	errno = saved_errno;
+}
+
+/** Move the samples taken by the signal handler into the map of distinct stacks. */
+static void ProcessSamples()
+{
+	if (_samples == nullptr) return;
+
+	std::vector<void *> stack;
+	for (size_t i = 0; i < NUM_SAMPLE_SLOTS; i++) {
+		Sample &sample = _samples[i];
+		if (!sample.ready.load(std::memory_order_acquire)) continue;
+
+		stack.assign(sample.frames.begin(), sample.frames.begin() + sample.depth);
+		_profile_stacks[stack]++;
+		sample.ready.store(false, std::memory_order_release);
+	}
+}
+
+/** Process the samples regularly, so the buffer does not fill up. */
+static const IntervalTimer<TimerGameRealtime> _sampling_profiler_process_interval({std::chrono::milliseconds(250), TimerGameRealtime::ALWAYS}, [](auto) {
+	if (_profiler_active.load(std::memory_order_relaxed)) ProcessSamples();
+});
+
+/**
+ * Get the name of the function a return address belongs to.
+ * @param address The return address.
+ * @return The demangled name of the function, or the module and offset when the function has no exported name.
+ */
+static std::string GetFrameName(void *address)
+{
+	Dl_info info;
+	if (dladdr(address, &info) == 0) return fmt::format("{}", address);
+
+	if (info.dli_sname != nullptr) {
+		int status;
+		char *demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+		if (demangled == nullptr) return info.dli_sname;
+
+		std::string name = demangled;
+		free(demangled);
+		return name;
+	}
+
+	std::string_view module = info.dli_fname != nullptr ? info.dli_fname : "";
+	auto separator = module.find_last_of('/');
+	if (separator != std::string_view::npos) module.remove_prefix(separator + 1);
+	return fmt::format("{}+{:#x}", module, reinterpret_cast<uintptr_t>(address) - reinterpret_cast<uintptr_t>(info.dli_fbase));
+}
+
+/**
+ * Register the bounds of the stack of the current thread, so the signal handler can
+ * safely walk the frames of that thread. Threads that are not registered only have
+ * their innermost frame sampled.
+ */
+void InitSamplingProfilerThread()
+{
+	pthread_attr_t attr;
+	if (pthread_getattr_np(pthread_self(), &attr) != 0) return;
+
+	void *addr;
+	size_t size;
+	if (pthread_attr_getstack(&attr, &addr, &size) == 0) {
+		_thread_stack_low = reinterpret_cast<uintptr_t>(addr);
+		_thread_stack_high = _thread_stack_low + size;
+	}
+	pthread_attr_destroy(&attr);
+}
+
+/**
+ * Check whether the sampling profiler is available on this platform.
+ * @return True iff the profiler can be started.
+ */
+bool IsSamplingProfilerSupported()
+{
+	return true;
+}
+
+/**
+ * Check whether the sampling profiler is running.
+ * @return True iff the profiler is running.
+ */
+bool IsSamplingProfilerActive()
+{
+	return _profiler_active.load();
+}
+
+/**
+ * Start sampling the stacks of all threads of the process.
+ * @param interval The CPU time between two samples.
+ * @return True iff the profiler was started.
+ */
+bool StartSamplingProfiler(std::chrono::microseconds interval)
+{
+	if (_profiler_active.load() || interval.count() <= 0) return false;
+
+	if (_samples == nullptr) _samples = std::make_unique<Sample[]>(NUM_SAMPLE_SLOTS);
+	InitSamplingProfilerThread();
+
+	_profile_stacks.clear();
+	_samples_taken = 0;
+	_samples_dropped = 0;
+
+	struct sigaction sa{};
+	sa.sa_sigaction = SamplingProfilerSignalHandler;
+	sa.sa_flags = SA_RESTART | SA_SIGINFO;
+	sigemptyset(&sa.sa_mask);
+	if (sigaction(SIGPROF, &sa, nullptr) != 0) return false;
+
+	_profiler_active.store(true);
+
+	struct itimerval timer{};
+	timer.it_interval.tv_sec = static_cast<time_t>(interval.count() / 1000000);
+	timer.it_interval.tv_usec = static_cast<suseconds_t>(interval.count() % 1000000);
+	timer.it_value = timer.it_interval;
+	if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+		_profiler_active.store(false);
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * Stop the sampling profiler and write the sampled stacks in the folded format.
+ * Every line contains the functions of a stack from the outermost to the innermost, separated
+ * by semicolons, followed by a space and the number of samples of that stack.
+ * The file is always written into the save directory; any path in the name is stripped.
+ * @param filename The name of the file to write the stacks to.
+ * @return Statistics of the profiler run, or \c std::nullopt if the file could not be written.
+ */
+std::optional<SamplingProfilerStats> StopSamplingProfiler(const std::string &filename)
+{
+	struct itimerval timer{};
+	setitimer(ITIMER_PROF, &timer, nullptr);
+	_profiler_active.store(false);
+	signal(SIGPROF, SIG_IGN);
+
+	ProcessSamples();
+
+	SamplingProfilerStats stats;
+	stats.samples = _samples_taken.load();
+	stats.dropped = _samples_dropped.load();
+	stats.stacks = _profile_stacks.size();
+
+	stats.filename = GetSanitizedFileBaseName(filename);
+	if (stats.filename.empty()) return std::nullopt;
+
+	auto f = FioFOpenFile(stats.filename, "w", SAVE_DIR);
+	if (!f.has_value()) return std::nullopt;
+
+	std::map<void *, std::string> names;
+	for (const auto &[stack, count] : _profile_stacks) {
+		std::string line;
+		for (auto it = stack.rbegin(); it != stack.rend(); ++it) {
+			auto [name, inserted] = names.try_emplace(*it);
+			if (inserted) name->second = GetFrameName(*it);
+			if (!line.empty()) line += ';';
+			line += name->second;
+		}
+		fmt::print(*f, "{} {}\n", line, count);
+	}
+	_profile_stacks.clear();
+
+	return stats;
+}
+
+#else
+
+void InitSamplingProfilerThread()
+{
+}
+
+bool IsSamplingProfilerSupported()
+{
+	return false;
+}
+
+bool IsSamplingProfilerActive()
+{
+	return false;
+}
+
+bool StartSamplingProfiler(std::chrono::microseconds)
+{
+	return false;
+}
+
+std::optional<SamplingProfilerStats> StopSamplingProfiler(const std::string &)
+{
+	return std::nullopt;
+}
+
+#endif /* WITH_SAMPLING_PROFILER */
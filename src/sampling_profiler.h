@@ -0,0 +1,29 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file sampling_profiler.h Functions for the built-in sampling profiler. */
+
+#ifndef SAMPLING_PROFILER_H
+#define SAMPLING_PROFILER_H
+
+#include <chrono>
+
+/** Statistics of a sampling profiler run. */
+struct SamplingProfilerStats {
+	uint64_t samples = 0; ///< Number of samples taken.
+	uint64_t dropped = 0; ///< Number of samples that were lost, as they were taken faster than they could be processed.
+	size_t stacks = 0; ///< Number of distinct stacks that were sampled.
+	std::string filename; ///< Name of the written file within the save directory.
+};
+
+void InitSamplingProfilerThread();
+bool IsSamplingProfilerSupported();
+bool IsSamplingProfilerActive();
+bool StartSamplingProfiler(std::chrono::microseconds interval);
+std::optional<SamplingProfilerStats> StopSamplingProfiler(const std::string &filename);
+
+#endif /* SAMPLING_PROFILER_H */
@@ -3106,14 +3106,12 @@ bool AfterLoadGame()
 	 * saved-by-server savegame. There are no clients with a backup, so clear it.
 	 * Furthermore before savegame version SLV_192 the actual content was always corrupt.
 	 */
-	if (!_networking || _network_server || IsSavegameVersionBefore(SLV_192)) {
-#ifndef DEBUG_DUMP_COMMANDS
+	if ((!_networking || _network_server || IsSavegameVersionBefore(SLV_192)) && !_network_replaying_commands) {
 		/* Note: We cannot use CleanPool since that skips part of the destructor
 		 * and then leaks un-reachable Orders in the order pool. */
 		for (OrderBackup *ob : OrderBackup::Iterate()) {
 			delete ob;
 		}
-#endif
 	}
 
 	if (IsSavegameVersionBefore(SLV_198)) {
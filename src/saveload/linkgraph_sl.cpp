@@ -43,9 +43,9 @@ public:
 
 	void Save(Node *bn) const override
 	{
-		SlSetStructListLength(bn->edges.size());
-		for (Edge &e : bn->edges) {
-			SlObject(&e, this->GetDescription());
+		SlSetStructListLength(bn->GetEdges().size());
+		for (const Edge &e : bn->GetEdges()) {
+			SlObject(const_cast<Edge *>(&e), this->GetDescription());
 		}
 	}
 
@@ -76,17 +76,18 @@ public:
 			}
 
 			/* Build edge list from edge matrix. */
+			std::vector<Edge> &node_edges = bn->GetMutableEdges();
 			for (NodeID to = edges[_linkgraph_from].dest_node; to != INVALID_NODE; to = edges[to].dest_node) {
-				auto &edge = bn->edges.emplace_back(edges[to]);
+				auto &edge = node_edges.emplace_back(edges[to]);
 				edge.dest_node = to;
 			}
 			/* Sort by destination. */
-			std::sort(bn->edges.begin(), bn->edges.end());
+			std::sort(node_edges.begin(), node_edges.end());
 		} else {
 			/* Edge data is now a simple vector and not any kind of matrix. */
 			size_t size = SlGetStructListLength(UINT16_MAX);
 			for (size_t i = 0; i < size; i++) {
-				auto &edge = bn->edges.emplace_back();
+				auto &edge = bn->GetMutableEdges().emplace_back();
 				SlObject(&edge, this->GetLoadDescription());
 			}
 		}
@@ -98,6 +99,7 @@ public:
 	static inline const SaveLoad description[] = {
 		SLE_CONDVAR(Node, xy,          SLE_UINT32, SLV_191, SL_MAX_VERSION),
 		    SLE_VAR(Node, supply,      SLE_UINT32),
+		SLE_CONDVAR(Node, demand_supply, SLE_UINT32, SLV_LINKGRAPH_DEMAND_SUPPLY, SL_MAX_VERSION),
 		    SLE_VAR(Node, demand,      SLE_UINT32),
 		    SLE_VAR(Node, station,     SLE_UINT16),
 		    SLE_VAR(Node, last_update, SLE_INT32),
@@ -125,6 +127,7 @@ public:
 		for (NodeID from = 0; from < length; ++from) {
 			_linkgraph_from = from;
 			SlObject(&lg->nodes[from], this->GetLoadDescription());
+			if (IsSavegameVersionBefore(SLV_LINKGRAPH_DEMAND_SUPPLY)) lg->nodes[from].demand_supply = lg->nodes[from].supply;
 		}
 	}
 };
@@ -184,6 +187,7 @@ SaveLoadTable GetLinkGraphJobDesc()
 	static const SaveLoad job_desc[] = {
 		SLE_VAR(LinkGraphJob, join_date,        SLE_INT32),
 		SLE_VAR(LinkGraphJob, link_graph.index, SLE_UINT16),
+		SLE_CONDVAR(LinkGraphJob, merged_nodes, SLE_UINT16, SLV_LINKGRAPH_MERGE_PROGRESS, SL_MAX_VERSION),
 		SLEG_STRUCT("linkgraph", SlLinkgraphJobProxy),
 	};
 
@@ -78,6 +78,8 @@ void ResetViewportAfterLoadGame()
 
 uint8_t _age_cargo_skip_counter; ///< Skip aging of cargo? Used before savegame version 162.
 extern TimeoutTimer<TimerGameTick> _new_competitor_timeout;
+extern AmortizedTimer<TimerGameEconomy> _economy_towns_monthly;
+extern AmortizedTimer<TimerGameEconomy> _economy_towns_yearly;
 
 static const SaveLoad _date_desc[] = {
 	SLEG_CONDVAR("date",                   TimerGameCalendar::date,                   SLE_FILE_U16 | SLE_VAR_I32,  SL_MIN_VERSION,  SLV_31),
@@ -104,6 +106,8 @@ static const SaveLoad _date_desc[] = {
 	SLEG_CONDVAR("competitors_interval",         _new_competitor_timeout.period.value,    SLE_UINT32,                  SLV_AI_START_DATE, SL_MAX_VERSION),
 	SLEG_CONDVAR("competitors_interval_elapsed", _new_competitor_timeout.storage.elapsed, SLE_UINT32,                  SLV_AI_START_DATE, SL_MAX_VERSION),
 	SLEG_CONDVAR("competitors_interval_fired",   _new_competitor_timeout.fired,           SLE_BOOL,                    SLV_AI_START_DATE, SL_MAX_VERSION),
+	SLEG_CONDVAR("towns_monthly_next_slice",     _economy_towns_monthly.next_slice,       SLE_UINT16,                  SLV_AMORTIZED_TIMER_SLICES, SL_MAX_VERSION),
+	SLEG_CONDVAR("towns_yearly_next_slice",      _economy_towns_yearly.next_slice,        SLE_UINT16,                  SLV_AMORTIZED_TIMER_SLICES, SL_MAX_VERSION),
 };
 
 static const SaveLoad _date_check_desc[] = {
@@ -48,6 +48,7 @@
 #include "../newgrf_railtype.h"
 #include "../newgrf_roadtype.h"
 #include "../settings_internal.h"
+#include "../framerate_type.h"
 #include "saveload_internal.h"
 #include "saveload_filter.h"
 
@@ -2979,6 +2980,8 @@ static void SaveFileError()
  */
 static SaveOrLoadResult SaveFileToDisk(bool threaded)
 {
+	PerformanceTraceScope trace("Savegame writing", threaded ? "ottd:savegame" : "");
+
 	try {
 		auto [fmt, compression] = GetSavegameFormat(_savegame_format);
 
@@ -3043,8 +3046,11 @@ static SaveOrLoadResult DoSave(std::shared_ptr<SaveFilter> writer, bool threaded
 
 	_sl_version = SAVEGAME_VERSION;
 
-	SaveViewportBeforeSaveGame();
-	SlSaveChunks();
+	{
+		PerformanceTraceScope trace("Savegame chunks");
+		SaveViewportBeforeSaveGame();
+		SlSaveChunks();
+	}
 
 	SaveFileStart();
 
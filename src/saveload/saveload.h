@@ -406,6 +406,9 @@ enum SaveLoadVersion : uint16_t {
 	SLV_FACE_STYLES,                        ///< 355  PR#14319 Addition of face styles, replacing gender and ethnicity.
 	SLV_INDUSTRY_NUM_VALID_HISTORY,         ///< 356  PR#14416 Store number of valid history records for industries.
 	SLV_INDUSTRY_ACCEPTED_HISTORY,          ///< 357  PR#14321 Add per-industry history of cargo delivered and waiting.
+	SLV_LINKGRAPH_MERGE_PROGRESS,           ///< 358  Merging link graph job results over multiple ticks.
+	SLV_LINKGRAPH_DEMAND_SUPPLY,            ///< 359  Supply used for calculating link graph demands.
+	SLV_AMORTIZED_TIMER_SLICES,             ///< 360  Remaining slices of the monthly and yearly town work.
 
 	SL_MAX_VERSION,                         ///< Highest possible saveload version
 };
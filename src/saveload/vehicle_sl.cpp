@@ -546,7 +546,7 @@ void AfterLoadVehiclesPhase2(bool part_of_load)
 	}
 }
 
-bool TrainController(Train *v, Vehicle *nomove, bool reverse = true); // From train_cmd.cpp
+bool TrainController(Train *v, Vehicle *nomove, bool reverse = true, bool line_end_checked = false); // From train_cmd.cpp
 void ReverseTrainDirection(Train *v);
 void ReverseTrainSwapVeh(Train *v, int l, int r);
 
@@ -308,6 +308,7 @@ struct NewsSettings {
 /** All settings related to the network. */
 struct NetworkSettings {
 	uint16_t      sync_freq;                                ///< how often do we check whether we are still in-sync
+	bool          sync_state_hash;                          ///< whether to send hashes of the game state with sync checks, to locate desyncs; hashes the whole map every sync
 	uint8_t       frame_freq;                               ///< how often do we send commands to the clients
 	uint16_t      commands_per_frame;                       ///< how many commands may be sent each frame_freq frames?
 	uint16_t      commands_per_frame_server;                ///< how many commands may be sent each frame_freq frames? (server-originating commands)
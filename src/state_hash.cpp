@@ -0,0 +1,179 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file state_hash.cpp Implementation of the hashes of the game state. */
+
+#include "stdafx.h"
+#include "state_hash.h"
+#include "map_func.h"
+#include "company_base.h"
+#include "station_base.h"
+#include "vehicle_base.h"
+
+#include "safeguards.h"
+
+/**
+ * Hasher producing the same result on every platform, as the hashes are compared between server and clients.
+ * This is the 32 bits variant of FNV-1a, fed one value at a time.
+ */
+class StateHasher {
+	uint32_t hash = 2166136261U; ///< Hash of the values added so far.
+
+public:
+	/**
+	 * Add a value to the hash.
+	 * @param value The value to add, which is fed in little endian order regardless of the platform.
+	 */
+	template <typename T>
+	void Add(T value)
+	{
+		uint64_t bits = static_cast<uint64_t>(value);
+		for (size_t i = 0; i < sizeof(T); i++) {
+			this->hash = (this->hash ^ static_cast<uint8_t>(bits)) * 16777619U;
+			bits >>= 8;
+		}
+	}
+
+	/**
+	 * Get the hash of the values added so far.
+	 * @return The hash.
+	 */
+	uint32_t GetHash() const { return this->hash; }
+};
+
+/**
+ * Get the number of map rows in each strip that is hashed separately.
+ * As map sizes are powers of two of at least #MIN_MAP_SIZE, the strips are all equally large.
+ * @return The number of rows.
+ */
+static uint GetMapRowsPerStrip()
+{
+	return Map::SizeY() / (SHP_MAP_END - SHP_MAP_BEGIN);
+}
+
+/**
+ * Hash the tiles of the map, in strips of rows.
+ * @param[out] hash The hashes to fill.
+ */
+static void HashMap(StateHash &hash)
+{
+	const uint rows_per_strip = GetMapRowsPerStrip();
+
+	for (uint strip = 0; strip < SHP_MAP_END - SHP_MAP_BEGIN; strip++) {
+		StateHasher hasher;
+		for (uint y = strip * rows_per_strip; y < (strip + 1) * rows_per_strip; y++) {
+			for (uint x = 0; x < Map::SizeX(); x++) {
+				Tile t(TileXY(x, y));
+				hasher.Add(t.type());
+				hasher.Add(t.height());
+				hasher.Add(t.m1());
+				hasher.Add(t.m2());
+				hasher.Add(t.m3());
+				hasher.Add(t.m4());
+				hasher.Add(t.m5());
+				hasher.Add(t.m6());
+				hasher.Add(t.m7());
+				hasher.Add(t.m8());
+			}
+		}
+		hash[SHP_MAP_BEGIN + strip] = hasher.GetHash();
+	}
+}
+
+/**
+ * Calculate the hashes of the parts of the game state.
+ * Only state that is synchronised between server and clients is hashed.
+ * @return The hashes.
+ */
+StateHash CalculateStateHash()
+{
+	StateHash hash{};
+	HashMap(hash);
+
+	StateHasher vehicles;
+	StateHasher cargo;
+	for (const Vehicle *v : Vehicle::Iterate()) {
+		vehicles.Add(v->index.base());
+		vehicles.Add(v->type);
+		vehicles.Add(v->tile.base());
+		vehicles.Add(v->x_pos);
+		vehicles.Add(v->y_pos);
+		vehicles.Add(v->z_pos);
+		vehicles.Add(v->cur_speed);
+		vehicles.Add(v->progress);
+		vehicles.Add(v->vehstatus.base());
+		vehicles.Add(v->reliability);
+		vehicles.Add(v->profit_this_year.base());
+
+		cargo.Add(v->index.base());
+		cargo.Add(v->cargo.TotalCount());
+		cargo.Add(v->cargo.GetFeederShare().base());
+	}
+	hash[SHP_VEHICLES] = vehicles.GetHash();
+
+	StateHasher stations;
+	for (const Station *st : Station::Iterate()) {
+		stations.Add(st->index.base());
+		stations.Add(st->xy.base());
+		stations.Add(st->facilities.base());
+		for (const GoodsEntry &ge : st->goods) {
+			stations.Add(ge.rating);
+			if (!ge.HasData()) continue;
+
+			cargo.Add(st->index.base());
+			cargo.Add(ge.GetData().cargo.TotalCount());
+		}
+	}
+	hash[SHP_STATIONS] = stations.GetHash();
+
+	cargo.Add(CargoPacket::GetNumItems());
+	hash[SHP_CARGO] = cargo.GetHash();
+
+	StateHasher companies;
+	for (const Company *c : Company::Iterate()) {
+		companies.Add(c->index.base());
+		companies.Add(c->money.base());
+		companies.Add(c->money_fraction);
+		companies.Add(c->current_loan.base());
+	}
+	hash[SHP_COMPANIES] = companies.GetHash();
+
+	return hash;
+}
+
+/**
+ * Combine the hashes of all parts into a single hash of the game state.
+ * @param hash The hashes of the parts.
+ * @return The combined hash.
+ */
+uint32_t CombineStateHash(const StateHash &hash)
+{
+	StateHasher hasher;
+	for (uint32_t part : hash) hasher.Add(part);
+	return hasher.GetHash();
+}
+
+/**
+ * Get a description of a part of the game state, for reporting where a desync occurred.
+ * @param part The part.
+ * @return The description.
+ */
+std::string GetStateHashPartName(StateHashPart part)
+{
+	if (part < SHP_MAP_END) {
+		const uint first_row = (part - SHP_MAP_BEGIN) * GetMapRowsPerStrip();
+		return fmt::format("map rows {} to {}", first_row, first_row + GetMapRowsPerStrip() - 1);
+	}
+
+	switch (part) {
+		case SHP_VEHICLES: return "vehicles";
+		case SHP_STATIONS: return "stations";
+		case SHP_COMPANIES: return "companies";
+		case SHP_CARGO: return "cargo";
+		default: NOT_REACHED();
+	}
+}
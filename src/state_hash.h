@@ -0,0 +1,31 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file state_hash.h Hashes of the game state, to locate where a desync occurred. */
+
+#ifndef STATE_HASH_H
+#define STATE_HASH_H
+
+/** Parts of the game state that are hashed separately. */
+enum StateHashPart : uint8_t {
+	SHP_MAP_BEGIN = 0, ///< First strip of map rows.
+	SHP_MAP_END = SHP_MAP_BEGIN + 16, ///< End of the strips of map rows.
+	SHP_VEHICLES = SHP_MAP_END, ///< Positions, speeds and status of vehicles.
+	SHP_STATIONS, ///< Locations, facilities and ratings of stations.
+	SHP_COMPANIES, ///< Money and loans of companies.
+	SHP_CARGO, ///< Cargo in vehicles and at stations.
+	SHP_END, ///< End marker.
+};
+
+/** Hashes of all parts of the game state. */
+using StateHash = std::array<uint32_t, SHP_END>;
+
+StateHash CalculateStateHash();
+uint32_t CombineStateHash(const StateHash &hash);
+std::string GetStateHashPartName(StateHashPart part);
+
+#endif /* STATE_HASH_H */
@@ -32,7 +32,24 @@ static const uint8_t MAX_STATION_RATING = 255;
  */
 class FlowStat {
 public:
-	typedef std::map<uint32_t, StationID> SharesMap;
+	/**
+	 * Shares of flow, sorted by their cumulative amount. Each entry holds the sum of the flows up to
+	 * and including its own, so a random number below the total selects a station with a probability
+	 * proportional to its flow. The shares are kept in a single contiguous array, as they are few and
+	 * looked up for every routing decision.
+	 */
+	class SharesMap : public std::vector<std::pair<uint32_t, StationID>> {
+	public:
+		/**
+		 * Find the share a value falls into.
+		 * @param share The value to look up.
+		 * @return The first entry with a cumulative share above the value, or end() if there is none.
+		 */
+		inline const_iterator upper_bound(uint32_t share) const
+		{
+			return std::ranges::upper_bound(*this, share, std::less{}, &value_type::first);
+		}
+	};
 
 	static const SharesMap empty_sharesmap;
 
@@ -52,7 +69,7 @@ public:
 	inline FlowStat(StationID st, uint flow, bool restricted = false)
 	{
 		assert(flow > 0);
-		this->shares[flow] = st;
+		this->shares.emplace_back(flow, st);
 		this->unrestricted = restricted ? 0 : flow;
 	}
 
@@ -67,7 +84,7 @@ public:
 	inline void AppendShare(StationID st, uint flow, bool restricted = false)
 	{
 		assert(flow > 0);
-		this->shares[(--this->shares.end())->first + flow] = st;
+		this->shares.emplace_back(this->shares.back().first + flow, st);
 		if (!restricted) this->unrestricted += flow;
 	}
 
@@ -116,7 +133,7 @@ public:
 	inline StationID GetViaWithRestricted(bool &is_restricted) const
 	{
 		assert(!this->shares.empty());
-		uint rand = RandomRange((--this->shares.end())->first);
+		uint rand = RandomRange(this->shares.back().first);
 		is_restricted = rand >= this->unrestricted;
 		return this->shares.upper_bound(rand)->second;
 	}
@@ -4032,13 +4032,18 @@ void DeleteStaleLinks(Station *from)
 		GoodsEntry &ge = from->goods[cargo];
 		LinkGraph *lg = LinkGraph::GetIfValid(ge.link_graph);
 		if (lg == nullptr) continue;
+		/* Only read the edges, so they stay shared with running jobs unless one is changed. */
+		const LinkGraph &graph = *lg;
 		std::vector<NodeID> to_remove{};
-		for (Edge &edge : (*lg)[ge.node].edges) {
-			Station *to = Station::Get((*lg)[edge.dest_node].station);
-			assert(to->goods[cargo].node == edge.dest_node);
-			assert(TimerGameEconomy::date >= edge.LastUpdate());
+		for (size_t i = 0; i < graph[ge.node].GetEdges().size(); ++i) {
+			/* Refreshing links below may add or copy edges of this node, so look the edge up anew on every use. */
+			const NodeID dest = graph[ge.node].GetEdges()[i].dest_node;
+			auto edge = [&]() -> const Edge & { return graph[ge.node][dest]; };
+			Station *to = Station::Get(graph[dest].station);
+			assert(to->goods[cargo].node == dest);
+			assert(TimerGameEconomy::date >= edge().LastUpdate());
 			auto timeout = TimerGameEconomy::Date(LinkGraph::MIN_TIMEOUT_DISTANCE + (DistanceManhattan(from->xy, to->xy) >> 3));
-			if (TimerGameEconomy::date - edge.LastUpdate() > timeout) {
+			if (TimerGameEconomy::date - edge().LastUpdate() > timeout) {
 				bool updated = false;
 
 				if (auto_distributed) {
@@ -4069,7 +4074,7 @@ void DeleteStaleLinks(Station *from)
 						if (!v->IsStoppedInDepot() || TimerGameEconomy::date - v->date_of_last_service <= LinkGraph::STALE_LINK_DEPOT_TIMEOUT) {
 							LinkRefresher::Run(v, false); // Don't allow merging. Otherwise lg might get deleted.
 						}
-						if (edge.LastUpdate() == TimerGameEconomy::date) {
+						if (edge().LastUpdate() == TimerGameEconomy::date) {
 							updated = true;
 							break;
 						}
@@ -4092,12 +4097,12 @@ void DeleteStaleLinks(Station *from)
 					if (ge.HasData()) ge.GetData().flows.DeleteFlows(to->index);
 					RerouteCargo(from, cargo, to->index, from->index);
 				}
-			} else if (edge.last_unrestricted_update != EconomyTime::INVALID_DATE && TimerGameEconomy::date - edge.last_unrestricted_update > timeout) {
-				edge.Restrict();
+			} else if (edge().last_unrestricted_update != EconomyTime::INVALID_DATE && TimerGameEconomy::date - edge().last_unrestricted_update > timeout) {
+				(*lg)[ge.node][dest].Restrict();
 				if (ge.HasData()) ge.GetData().flows.RestrictFlows(to->index);
 				RerouteCargo(from, cargo, to->index, from->index);
-			} else if (edge.last_restricted_update != EconomyTime::INVALID_DATE && TimerGameEconomy::date - edge.last_restricted_update > timeout) {
-				edge.Release();
+			} else if (edge().last_restricted_update != EconomyTime::INVALID_DATE && TimerGameEconomy::date - edge().last_restricted_update > timeout) {
+				(*lg)[ge.node][dest].Release();
 			}
 		}
 		/* Remove dead edges. */
@@ -4858,13 +4863,14 @@ void FlowStat::Invalidate()
 {
 	assert(!this->shares.empty());
 	SharesMap new_shares;
+	new_shares.reserve(this->shares.size());
 	uint i = 0;
 	for (const auto &it : this->shares) {
-		new_shares[++i] = it.second;
+		new_shares.emplace_back(++i, it.second);
 		if (it.first == this->unrestricted) this->unrestricted = i;
 	}
 	this->shares.swap(new_shares);
-	assert(!this->shares.empty() && this->unrestricted <= (--this->shares.end())->first);
+	assert(!this->shares.empty() && this->unrestricted <= this->shares.back().first);
 }
 
 /**
@@ -4883,6 +4889,7 @@ void FlowStat::ChangeShare(StationID st, int flow)
 	uint added_shares = 0;
 	uint last_share = 0;
 	SharesMap new_shares;
+	new_shares.reserve(this->shares.size() + 1);
 	for (const auto &it : this->shares) {
 		if (it.second == st) {
 			if (flow < 0) {
@@ -4904,11 +4911,11 @@ void FlowStat::ChangeShare(StationID st, int flow)
 			 * removed. */
 			flow = 0;
 		}
-		new_shares[it.first + added_shares - removed_shares] = it.second;
+		new_shares.emplace_back(it.first + added_shares - removed_shares, it.second);
 		last_share = it.first;
 	}
 	if (flow > 0) {
-		new_shares[last_share + (uint)flow] = st;
+		new_shares.emplace_back(last_share + (uint)flow, st);
 		if (this->unrestricted < last_share) {
 			this->ReleaseShare(st);
 		} else {
@@ -4929,6 +4936,7 @@ void FlowStat::RestrictShare(StationID st)
 	uint flow = 0;
 	uint last_share = 0;
 	SharesMap new_shares;
+	new_shares.reserve(this->shares.size());
 	for (auto &it : this->shares) {
 		if (flow == 0) {
 			if (it.first > this->unrestricted) return; // Not present or already restricted.
@@ -4936,15 +4944,15 @@ void FlowStat::RestrictShare(StationID st)
 				flow = it.first - last_share;
 				this->unrestricted -= flow;
 			} else {
-				new_shares[it.first] = it.second;
+				new_shares.emplace_back(it.first, it.second);
 			}
 		} else {
-			new_shares[it.first - flow] = it.second;
+			new_shares.emplace_back(it.first - flow, it.second);
 		}
 		last_share = it.first;
 	}
 	if (flow == 0) return;
-	new_shares[last_share + flow] = st;
+	new_shares.emplace_back(last_share + flow, st);
 	this->shares.swap(new_shares);
 	assert(!this->shares.empty());
 }
@@ -4974,10 +4982,11 @@ void FlowStat::ReleaseShare(StationID st)
 	}
 	if (flow == 0) return;
 	SharesMap new_shares;
-	new_shares[flow] = st;
+	new_shares.reserve(this->shares.size());
+	new_shares.emplace_back(flow, st);
 	for (SharesMap::iterator it(this->shares.begin()); it != this->shares.end(); ++it) {
 		if (it->second != st) {
-			new_shares[flow + it->first] = it->second;
+			new_shares.emplace_back(flow + it->first, it->second);
 		} else {
 			flow = 0;
 		}
@@ -4995,10 +5004,11 @@ void FlowStat::ScaleToMonthly(uint runtime)
 {
 	assert(runtime > 0);
 	SharesMap new_shares;
+	new_shares.reserve(this->shares.size());
 	uint share = 0;
 	for (auto i : this->shares) {
 		share = std::max(share + 1, i.first * 30 / runtime);
-		new_shares[share] = i.second;
+		new_shares.emplace_back(share, i.second);
 		if (this->unrestricted == i.first) this->unrestricted = share;
 	}
 	this->shares.swap(new_shares);
@@ -5118,7 +5128,7 @@ uint FlowStatMap::GetFlow() const
 {
 	uint ret = 0;
 	for (const auto &it : *this) {
-		ret += (--(it.second.GetShares()->end()))->first;
+		ret += it.second.GetShares()->back().first;
 	}
 	return ret;
 }
@@ -5146,7 +5156,7 @@ uint FlowStatMap::GetFlowFrom(StationID from) const
 {
 	FlowStatMap::const_iterator i = this->find(from);
 	if (i == this->end()) return 0;
-	return (--(i->second.GetShares()->end()))->first;
+	return i->second.GetShares()->back().first;
 }
 
 /**
@@ -0,0 +1,92 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file demands_node_queue.cpp Test functionality of the node queue of the demand calculation. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../linkgraph/demands.h"
+
+#include "../safeguards.h"
+
+/**
+ * Pop all nodes from a queue.
+ * @param queue The queue to empty.
+ * @return The popped nodes, in order.
+ */
+static std::vector<NodeID> PopAll(NodeQueue &queue)
+{
+	std::vector<NodeID> result;
+	while (!queue.empty()) {
+		result.push_back(queue.front());
+		queue.pop();
+	}
+	return result;
+}
+
+TEST_CASE("NodeQueue - first in, first out")
+{
+	NodeQueue queue(3);
+	CHECK(queue.empty());
+
+	queue.push(1);
+	queue.push(2);
+	queue.push(3);
+	CHECK(!queue.empty());
+	CHECK(queue.front() == 1);
+
+	CHECK(PopAll(queue) == std::vector<NodeID>{1, 2, 3});
+	CHECK(queue.empty());
+}
+
+TEST_CASE("NodeQueue - wrap around")
+{
+	NodeQueue queue(3);
+	queue.push(1);
+	queue.push(2);
+	queue.pop();
+	queue.pop();
+
+	/* The buffer now starts at its end, so these wrap around to its start. */
+	queue.push(3);
+	queue.push(4);
+	queue.push(5);
+	CHECK(PopAll(queue) == std::vector<NodeID>{3, 4, 5});
+
+	/* A single slot wraps around on every push. */
+	NodeQueue single(1);
+	for (NodeID node = 0; node < 5; node++) {
+		single.push(node);
+		CHECK(single.front() == node);
+		single.pop();
+		CHECK(single.empty());
+	}
+}
+
+TEST_CASE("NodeQueue - requeue the front node")
+{
+	/* The demand calculation pops nodes and pushes them back while they have something left. */
+	NodeQueue queue(4);
+	for (NodeID node = 0; node < 4; node++) queue.push(node);
+
+	for (uint round = 0; round < 10; round++) {
+		for (NodeID node = 0; node < 4; node++) {
+			CHECK(queue.front() == node);
+			queue.pop();
+			queue.push(node);
+		}
+	}
+
+	/* Drop the odd nodes in the next round. */
+	for (NodeID node = 0; node < 4; node++) {
+		queue.pop();
+		if (node % 2 == 0) queue.push(node);
+	}
+	CHECK(PopAll(queue) == std::vector<NodeID>{0, 2});
+}
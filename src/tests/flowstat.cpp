@@ -0,0 +1,169 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file flowstat.cpp Test functionality of the flow shares of stations. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../station_base.h"
+#include "../core/random_func.hpp"
+
+#include "../safeguards.h"
+
+static const StationID A{1};
+static const StationID B{2};
+static const StationID C{3};
+static const StationID D{4};
+
+/** Expected cumulative shares of a flow, in order. */
+using ExpectedShares = std::vector<std::pair<uint32_t, StationID>>;
+
+/**
+ * Check the shares and the unrestricted limit of a flow.
+ * @param flow The flow to check.
+ * @param expected The expected cumulative shares.
+ * @param unrestricted The expected limit of unrestricted shares.
+ */
+static void CheckShares(const FlowStat &flow, const ExpectedShares &expected, uint unrestricted)
+{
+	const FlowStat::SharesMap &shares = *flow.GetShares();
+	REQUIRE(shares.size() == expected.size());
+	for (size_t i = 0; i < expected.size(); ++i) {
+		CHECK(shares[i].first == expected[i].first);
+		CHECK(shares[i].second == expected[i].second);
+	}
+	CHECK(flow.GetUnrestricted() == unrestricted);
+}
+
+/**
+ * Create a flow of 10 via A, 20 via B and 5 via C.
+ * @return The flow.
+ */
+static FlowStat CreateFlow()
+{
+	FlowStat flow(A, 10);
+	flow.AppendShare(B, 20);
+	flow.AppendShare(C, 5);
+	return flow;
+}
+
+TEST_CASE("FlowStat - share lookup")
+{
+	FlowStat flow = CreateFlow();
+	CheckShares(flow, {{10, A}, {30, B}, {35, C}}, 35);
+
+	CHECK(flow.GetShare(A) == 10);
+	CHECK(flow.GetShare(B) == 20);
+	CHECK(flow.GetShare(C) == 5);
+	CHECK(flow.GetShare(D) == 0);
+
+	/* A random number in [0, 35) selects the share whose interval contains it. */
+	const FlowStat::SharesMap &shares = *flow.GetShares();
+	CHECK(shares.upper_bound(0)->second == A);
+	CHECK(shares.upper_bound(9)->second == A);
+	CHECK(shares.upper_bound(10)->second == B);
+	CHECK(shares.upper_bound(29)->second == B);
+	CHECK(shares.upper_bound(30)->second == C);
+	CHECK(shares.upper_bound(34)->second == C);
+	CHECK(shares.upper_bound(35) == shares.end());
+}
+
+TEST_CASE("FlowStat - ChangeShare")
+{
+	FlowStat flow = CreateFlow();
+
+	/* Reduce a share in the middle; later shares move down. */
+	flow.ChangeShare(B, -5);
+	CheckShares(flow, {{10, A}, {25, B}, {30, C}}, 30);
+
+	/* Remove a share completely. */
+	flow.ChangeShare(A, INT_MIN);
+	CheckShares(flow, {{15, B}, {20, C}}, 20);
+
+	/* A new next hop is appended as unrestricted flow. */
+	flow.ChangeShare(D, 7);
+	CheckShares(flow, {{15, B}, {20, C}, {27, D}}, 27);
+
+	/* Increase a share in the middle; later shares move up. */
+	flow.ChangeShare(C, 3);
+	CheckShares(flow, {{15, B}, {23, C}, {30, D}}, 30);
+
+	/* Removing more than the share removes the whole share. */
+	flow.ChangeShare(D, -10);
+	CheckShares(flow, {{15, B}, {23, C}}, 23);
+}
+
+TEST_CASE("FlowStat - RestrictShare and ReleaseShare")
+{
+	FlowStat flow = CreateFlow();
+
+	/* The restricted share moves behind the unrestricted ones; it is appended after the previous total. */
+	flow.RestrictShare(A);
+	CheckShares(flow, {{20, B}, {25, C}, {45, A}}, 25);
+
+	/* Restricting again or restricting an unknown station changes nothing. */
+	flow.RestrictShare(A);
+	flow.RestrictShare(D);
+	CheckShares(flow, {{20, B}, {25, C}, {45, A}}, 25);
+
+	/* Releasing moves the share back to the front. */
+	flow.ReleaseShare(A);
+	CheckShares(flow, {{20, A}, {40, B}, {45, C}}, 45);
+
+	/* Adding flow to a restricted next hop keeps it restricted. */
+	flow.RestrictShare(C);
+	CheckShares(flow, {{20, A}, {40, B}, {50, C}}, 40);
+	flow.ChangeShare(C, 5);
+	CheckShares(flow, {{20, A}, {40, B}, {55, C}}, 40);
+
+	/* A new next hop behind restricted ones is restricted as well. */
+	flow.ChangeShare(D, 5);
+	CheckShares(flow, {{20, A}, {40, B}, {55, C}, {60, D}}, 40);
+}
+
+TEST_CASE("FlowStat - GetVia")
+{
+	SetRandomSeed(4711);
+
+	FlowStat flow = CreateFlow();
+	flow.RestrictShare(C);
+
+	/* Restricted next hops are never selected, unless asked for. */
+	std::set<StationID> seen;
+	for (int i = 0; i < 1000; i++) seen.insert(flow.GetVia());
+	CHECK(seen == std::set<StationID>{A, B});
+
+	seen.clear();
+	for (int i = 0; i < 1000; i++) {
+		bool is_restricted;
+		StationID via = flow.GetViaWithRestricted(is_restricted);
+		CHECK(is_restricted == (via == C));
+		seen.insert(via);
+	}
+	CHECK(seen == std::set<StationID>{A, B, C});
+
+	/* Excluded next hops are never selected. */
+	flow.ReleaseShare(C);
+	flow.ChangeShare(D, 5);
+	for (int i = 0; i < 1000; i++) {
+		StationID via = flow.GetVia(B);
+		CHECK(via != B);
+		CHECK(via != StationID::Invalid());
+
+		via = flow.GetVia(A, C);
+		CHECK((via == B || via == D));
+	}
+
+	/* Without any other next hop there is nothing to select. */
+	FlowStat single(A, 10);
+	CHECK(single.GetVia(A) == StationID::Invalid());
+	single.AppendShare(B, 10);
+	CHECK(single.GetVia(A, B) == StationID::Invalid());
+	CHECK(single.GetVia(B, A) == StationID::Invalid());
+}
@@ -13,6 +13,7 @@
 #include "debug.h"
 #include "crashlog.h"
 #include "error_func.h"
+#include "sampling_profiler.h"
 #include <system_error>
 #include <thread>
 #include <mutex>
@@ -60,6 +61,7 @@ inline bool StartNewThread(std::thread *thr, std::string_view name, TFn&& _Fx, T
 
 				SetCurrentThreadName(name);
 				CrashLog::InitThread();
+				InitSamplingProfilerThread();
 				try {
 					/* Call user function with the given arguments. */
 					F(A...);
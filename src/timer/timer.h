@@ -108,6 +108,86 @@ private:
 	void Elapsed(TElapsed count) override;
 };
 
+/**
+ * An amortized timer spreads the work of every period over multiple ticks, instead of doing it all at once.
+ *
+ * The callback receives the slice of the work to do. The first slice is done when the period
+ * triggers, the other slices in the following ticks. The remaining slices are only done for a
+ * period of which the first slice was done; the slice to do next has to be saved for that.
+ *
+ * The work of a slice should be chosen such that all slices together do the work of the period
+ * exactly once, e.g. by handling each object whose index modulo the number of slices equals the slice.
+ *
+ * Each Timer-type needs to implement the Elapsed() and Tick() methods, and call the callback if needed.
+ * The timer manager calls Tick() of the amortized timers every tick in which no period triggers.
+ */
+template <typename TTimerType>
+class AmortizedTimer : public BaseTimer<TTimerType> {
+public:
+	using TPeriod = typename TTimerType::TPeriod;
+	using TElapsed = typename TTimerType::TElapsed;
+
+	/**
+	 * Create a new amortized timer.
+	 *
+	 * @param interval The interval in which to do the work of each period.
+	 * @param callback The callback to call for each slice of the work.
+	 */
+	[[nodiscard]] AmortizedTimer(const TPeriod interval, std::function<void(uint)> callback) :
+		BaseTimer<TTimerType>(interval),
+		callback(std::move(callback))
+	{
+		GetAmortizedTimers().insert(this);
+	}
+
+	/**
+	 * Delete the timer.
+	 */
+	~AmortizedTimer() override
+	{
+		GetAmortizedTimers().erase(this);
+	}
+
+	/**
+	 * Forget the remaining slices of all amortized timers, e.g. when a new game is started.
+	 */
+	static void ResetAll()
+	{
+		for (AmortizedTimer *timer : GetAmortizedTimers()) timer->next_slice = 0;
+	}
+
+	/* Although these variables are public, they are only public to make saveload easier; not for common use. */
+
+	uint16_t next_slice = 0; ///< The slice to do in the next tick, or 0 when all slices of the period are done.
+
+private:
+	std::function<void(uint)> callback;
+
+	void Elapsed(TElapsed count) override;
+	void Tick();
+
+	/**
+	 * Sorter for amortized timers, in the same order as the timer manager uses.
+	 */
+	struct amortized_timer_sorter {
+		bool operator() (AmortizedTimer *a, AmortizedTimer *b) const
+		{
+			if (a->period == b->period) return a < b;
+			return a->period < b->period;
+		}
+	};
+
+	/** Singleton list, to store the amortized timers apart from the other timers, as only they need to be called every tick. */
+	static std::set<AmortizedTimer *, amortized_timer_sorter> &GetAmortizedTimers()
+	{
+		static std::set<AmortizedTimer *, amortized_timer_sorter> timers;
+		return timers;
+	}
+
+	/* To ensure only TimerManager can access Tick. */
+	friend class TimerManager<TTimerType>;
+};
+
 /**
  * A timeout timer will fire once after the interval. You can reset it to fire again.
  * The timer will never fire before the interval has passed, but in times of severe stress it might be late.
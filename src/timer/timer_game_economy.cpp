@@ -121,6 +121,26 @@ void TimeoutTimer<TimerGameEconomy>::Elapsed(TimerGameEconomy::TElapsed trigger)
 	}
 }
 
+template <>
+void AmortizedTimer<TimerGameEconomy>::Elapsed(TimerGameEconomy::TElapsed trigger)
+{
+	if (trigger == this->period.trigger) {
+		this->callback(0);
+		this->next_slice = 1;
+	}
+}
+
+/* The remaining slices are done in the other ticks of the first day of the period; one slice per tick. */
+template <>
+void AmortizedTimer<TimerGameEconomy>::Tick()
+{
+	if (this->next_slice == 0) return;
+
+	uint slice = this->next_slice;
+	this->next_slice = (slice + 1 < Ticks::DAY_TICKS) ? slice + 1 : 0;
+	this->callback(slice);
+}
+
 template <>
 bool TimerManager<TimerGameEconomy>::Elapsed([[maybe_unused]] TimerGameEconomy::TElapsed delta)
 {
@@ -129,7 +149,12 @@ bool TimerManager<TimerGameEconomy>::Elapsed([[maybe_unused]] TimerGameEconomy::
 	if (_game_mode == GM_MENU) return false;
 
 	TimerGameEconomy::date_fract++;
-	if (TimerGameEconomy::date_fract < Ticks::DAY_TICKS) return true;
+	if (TimerGameEconomy::date_fract < Ticks::DAY_TICKS) {
+		for (auto timer : AmortizedTimer<TimerGameEconomy>::GetAmortizedTimers()) {
+			timer->Tick();
+		}
+		return true;
+	}
 	TimerGameEconomy::date_fract = 0;
 
 	/* increase day counter */
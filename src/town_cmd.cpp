@@ -4050,9 +4050,12 @@ CommandCost CheckforTownRating(DoCommandFlags flags, Town *t, TownRatingCheckTyp
 	return CommandCost();
 }
 
-static const IntervalTimer<TimerGameEconomy> _economy_towns_monthly({TimerGameEconomy::MONTH, TimerGameEconomy::Priority::TOWN}, [](auto)
+/* The monthly work of the towns is spread over the ticks of the first day of the month; each town is handled in the tick of its index. */
+AmortizedTimer<TimerGameEconomy> _economy_towns_monthly({TimerGameEconomy::MONTH, TimerGameEconomy::Priority::TOWN}, [](uint slice)
 {
 	for (Town *t : Town::Iterate()) {
+		if (t->index.base() % Ticks::DAY_TICKS != static_cast<int>(slice)) continue;
+
 		/* Check for active town actions and decrement their counters. */
 		if (t->road_build_months != 0) t->road_build_months--;
 		if (t->fund_buildings_months != 0) t->fund_buildings_months--;
@@ -4077,12 +4080,15 @@ static const IntervalTimer<TimerGameEconomy> _economy_towns_monthly({TimerGameEc
 	}
 });
 
-static const IntervalTimer<TimerGameEconomy> _economy_towns_yearly({TimerGameEconomy::YEAR, TimerGameEconomy::Priority::TOWN}, [](auto)
+AmortizedTimer<TimerGameEconomy> _economy_towns_yearly({TimerGameEconomy::YEAR, TimerGameEconomy::Priority::TOWN}, [](uint slice)
 {
-	/* Increment house ages */
-	for (const auto t : Map::Iterate()) {
-		if (!IsTileType(t, MP_HOUSE)) continue;
-		IncrementHouseAge(t);
+	/* Increment house ages, one in every DAY_TICKS rows of the map per tick. */
+	for (uint y = slice; y < Map::SizeY(); y += Ticks::DAY_TICKS) {
+		for (uint x = 0; x < Map::SizeX(); x++) {
+			TileIndex t = TileXY(x, y);
+			if (!IsTileType(t, MP_HOUSE)) continue;
+			IncrementHouseAge(t);
+		}
 	}
 });
 
@@ -46,7 +46,7 @@
 
 static Track ChooseTrainTrack(Train *v, TileIndex tile, DiagDirection enterdir, TrackBits tracks, bool force_res, bool *got_reservation, bool mark_stuck);
 static bool TrainCheckIfLineEnds(Train *v, bool reverse = true);
-bool TrainController(Train *v, Vehicle *nomove, bool reverse = true); // Also used in vehicle_sl.cpp.
+bool TrainController(Train *v, Vehicle *nomove, bool reverse = true, bool line_end_checked = false); // Also used in vehicle_sl.cpp.
 static TileIndex TrainApproachingCrossingTile(const Train *v);
 static void CheckIfTrainNeedsService(Train *v);
 static void CheckNextTrainTile(Train *v);
@@ -1679,6 +1679,8 @@ void ReverseTrainSwapVeh(Train *v, int l, int r)
 		SwapTrainFlags(&a->gv_flags, &a->gv_flags);
 		UpdateStatusAfterSwap(a);
 	}
+
+	v->InvalidateSlopeResistance();
 }
 
 /**
@@ -3235,16 +3237,16 @@ static bool CheckTrainCollision(Train *v)
 
 	uint num_victims = 0;
 
-	/* find colliding vehicles */
+	/* find colliding vehicles, only trains can be involved */
 	if (v->track == TRACK_BIT_WORMHOLE) {
-		for (Vehicle *u : VehiclesOnTile(v->tile)) {
+		for (Vehicle *u : VehiclesOnTile(v->tile, VEH_TRAIN)) {
 			num_victims += CheckTrainCollision(u, v);
 		}
-		for (Vehicle *u : VehiclesOnTile(GetOtherTunnelBridgeEnd(v->tile))) {
+		for (Vehicle *u : VehiclesOnTile(GetOtherTunnelBridgeEnd(v->tile), VEH_TRAIN)) {
 			num_victims += CheckTrainCollision(u, v);
 		}
 	} else {
-		for (Vehicle *u : VehiclesNearTileXY(v->x_pos, v->y_pos, 7)) {
+		for (Vehicle *u : VehiclesNearTileXY(v->x_pos, v->y_pos, 7, VEH_TRAIN)) {
 			num_victims += CheckTrainCollision(u, v);
 		}
 	}
@@ -3259,14 +3261,38 @@ static bool CheckTrainCollision(Train *v)
 	return true;
 }
 
+/**
+ * Check whether a train part that stays within its current tile has to be
+ * presented to the tile's enter callback.
+ * On plain rail, station and level crossing tiles the callback only acts on
+ * the front engine, so the other parts of the consist just follow the path of
+ * the front engine and only depots and tunnel/bridge heads, which act on every
+ * part of the consist, need the callback.
+ * @param v The train part that is moving.
+ * @param tile The tile the part stays on.
+ * @return True if #VehicleEnterTile must be called for this step.
+ */
+static inline bool TrainPartNeedsEnterTile(const Train *v, TileIndex tile)
+{
+	if (v->IsFrontEngine()) return true;
+
+	switch (GetTileType(tile)) {
+		case MP_RAILWAY: return IsRailDepot(tile);
+		case MP_STATION:
+		case MP_ROAD: return false;
+		default: return true;
+	}
+}
+
 /**
  * Move a vehicle chain one movement stop forwards.
  * @param v First vehicle to move.
  * @param nomove Stop moving this and all following vehicles.
  * @param reverse Set to false to not execute the vehicle reversing. This does not change any other logic.
+ * @param line_end_checked The front engine has just passed #TrainCheckIfLineEnds at its current position, so it does not need to be repeated for this step.
  * @return True if the vehicle could be moved forward, false otherwise.
  */
-bool TrainController(Train *v, Vehicle *nomove, bool reverse)
+bool TrainController(Train *v, Vehicle *nomove, bool reverse, bool line_end_checked)
 {
 	Train *first = v->First();
 	Train *prev;
@@ -3290,15 +3316,17 @@ bool TrainController(Train *v, Vehicle *nomove, bool reverse)
 					/* Not inside depot */
 
 					/* Reverse when we are at the end of the track already, do not move to the new position */
-					if (v->IsFrontEngine() && !TrainCheckIfLineEnds(v, reverse)) return false;
+					if (v->IsFrontEngine() && !line_end_checked && !TrainCheckIfLineEnds(v, reverse)) return false;
 
-					auto vets = VehicleEnterTile(v, gp.new_tile, gp.x, gp.y);
-					if (vets.Test(VehicleEnterTileState::CannotEnter)) {
-						goto invalid_rail;
-					}
-					if (vets.Test(VehicleEnterTileState::EnteredStation)) {
-						/* The new position is the end of the platform */
-						TrainEnterStation(v, GetStationIndex(gp.new_tile));
+					if (TrainPartNeedsEnterTile(v, gp.new_tile)) {
+						auto vets = VehicleEnterTile(v, gp.new_tile, gp.x, gp.y);
+						if (vets.Test(VehicleEnterTileState::CannotEnter)) {
+							goto invalid_rail;
+						}
+						if (vets.Test(VehicleEnterTileState::EnteredStation)) {
+							/* The new position is the end of the platform */
+							TrainEnterStation(v, GetStationIndex(gp.new_tile));
+						}
 					}
 				}
 			} else {
@@ -4027,11 +4055,16 @@ static bool TrainLocoHandler(Train *v, bool mode)
 		/* if the vehicle has speed 0, update the last_speed field. */
 		if (v->cur_speed == 0) v->SetLastSpeed();
 	} else {
-		TrainCheckIfLineEnds(v);
+		/* Nothing changes between this check and the first step, so when the train
+		 * did not have to reverse the first step does not need to repeat it. */
+		bool line_end_checked = TrainCheckIfLineEnds(v);
+		/* Update the viewport only once after all movement steps. */
+		_vehicle_viewport_update_batch = v;
 		/* Loop until the train has finished moving. */
 		for (;;) {
 			j -= adv_spd;
-			TrainController(v, nullptr);
+			TrainController(v, nullptr, true, line_end_checked);
+			line_end_checked = false;
 			/* Don't continue to move if the train crashed. */
 			if (CheckTrainCollision(v)) break;
 			/* Determine distance to next map position */
@@ -4049,13 +4082,12 @@ static bool TrainLocoHandler(Train *v, bool mode)
 				ProcessOrders(v);
 			}
 		}
+		_vehicle_viewport_update_batch = nullptr;
 		v->SetLastSpeed();
 	}
 
 	for (Train *u = v; u != nullptr; u = u->Next()) {
-		if (u->vehstatus.Test(VehState::Hidden)) continue;
-
-		u->UpdateViewport(false, false);
+		u->UpdateViewportAfterMovement();
 	}
 
 	if (v->progress == 0) v->progress = j; // Save unused spd for next time, if TrainController didn't set progress
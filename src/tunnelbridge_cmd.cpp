@@ -1889,7 +1889,7 @@ static void ChangeTileOwner_TunnelBridge(TileIndex tile, Owner old_owner, Owner
  * called for the wormhole of the bridge and as such the going up/down bits
  * would remain set. As such, this function clears those. In doing so, the call
  * to UpdateInclination will not update the Z-coordinate, so that has to be
- * done here as well.
+ * done here as well, and the cached slope resistance has to be invalidated.
  * @param gv The ground vehicle entering the bridge.
  */
 template <typename T>
@@ -1901,6 +1901,7 @@ static void PrepareToEnterBridge(T *gv)
 	} else {
 		ClrBit(gv->gv_flags, GVF_GOINGDOWN_BIT);
 	}
+	gv->InvalidateSlopeResistance();
 }
 
 /**
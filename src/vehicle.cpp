@@ -193,31 +193,41 @@ void VehicleServiceInDepot(Vehicle *v)
 }
 
 /**
- * Check if the vehicle needs to go to a depot in near future (if a opportunity presents itself) for service or replacement.
- *
- * @see NeedsAutomaticServicing()
- * @return true if the vehicle should go to a depot if a opportunity presents itself.
+ * Check whether the service interval of the vehicle has elapsed, i.e. it is time for its next service.
+ * This is the cheap part of #NeedsServicing, which only depends on the vehicle itself.
+ * @return true if the vehicle is moving and due for service.
  */
-bool Vehicle::NeedsServicing() const
+bool Vehicle::IsServiceIntervalElapsed() const
 {
 	/* Stopped or crashed vehicles will not move, as such making unmovable
 	 * vehicles to go for service is lame. */
 	if (this->vehstatus.Any({VehState::Stopped, VehState::Crashed})) return false;
 
-	/* Are we ready for the next service cycle? */
-	const Company *c = Company::Get(this->owner);
-
 	/* Service intervals can be measured in different units, which we handle individually. */
 	if (this->ServiceIntervalIsPercent()) {
 		/* Service interval is in percents. */
-		if (this->reliability >= this->GetEngine()->reliability * (100 - this->GetServiceInterval()) / 100) return false;
+		return this->reliability < this->GetEngine()->reliability * (100 - this->GetServiceInterval()) / 100;
 	} else if (TimerGameEconomy::UsingWallclockUnits()) {
 		/* Service interval is in minutes. */
-		if (this->date_of_last_service + (this->GetServiceInterval() * EconomyTime::DAYS_IN_ECONOMY_MONTH) >= TimerGameEconomy::date) return false;
+		return this->date_of_last_service + (this->GetServiceInterval() * EconomyTime::DAYS_IN_ECONOMY_MONTH) < TimerGameEconomy::date;
 	} else {
 		/* Service interval is in days. */
-		if (this->date_of_last_service + this->GetServiceInterval() >= TimerGameEconomy::date) return false;
+		return this->date_of_last_service + this->GetServiceInterval() < TimerGameEconomy::date;
 	}
+}
+
+/**
+ * Check if the vehicle needs to go to a depot in near future (if a opportunity presents itself) for service or replacement.
+ *
+ * @see NeedsAutomaticServicing()
+ * @return true if the vehicle should go to a depot if a opportunity presents itself.
+ */
+bool Vehicle::NeedsServicing() const
+{
+	/* Are we ready for the next service cycle? */
+	if (!this->IsServiceIntervalElapsed()) return false;
+
+	const Company *c = Company::Get(this->owner);
 
 	/* If we're servicing anyway, because we have not disabled servicing when
 	 * there are no breakdowns or we are playing with breakdowns, bail out. */
@@ -282,9 +292,11 @@ bool Vehicle::NeedsServicing() const
  */
 bool Vehicle::NeedsAutomaticServicing() const
 {
-	if (this->HasDepotOrder()) return false;
+	/* Most vehicles are not due for service on most days; check that before walking the orders. */
+	if (!this->IsServiceIntervalElapsed()) return false;
 	if (this->current_order.IsType(OT_LOADING)) return false;
 	if (this->current_order.IsType(OT_GOTO_DEPOT) && (this->current_order.GetDepotOrderType() & ODTFB_SERVICE) == 0) return false;
+	if (this->HasDepotOrder()) return false;
 	return NeedsServicing();
 }
 
@@ -425,11 +437,42 @@ static inline uint GetTileHash(uint x, uint y)
 
 static std::array<Vehicle *, TOTAL_TILE_HASH_SIZE> _vehicle_tile_hash{};
 
+/**
+ * Tile location hashes holding only the vehicles of a single company vehicle type.
+ * They share their buckets with #_vehicle_tile_hash, so e.g. train collision checks
+ * do not have to visit the road vehicles and effects that share a bucket with them.
+ */
+static std::array<std::array<Vehicle *, TOTAL_TILE_HASH_SIZE>, VEH_COMPANY_END> _vehicle_type_tile_hash{};
+
+/**
+ * Get the first vehicle of a tile hash bucket.
+ * @param hash The bucket.
+ * @param type The vehicle type to get the bucket for, or #VEH_INVALID for all vehicles.
+ * @return The first vehicle in the bucket.
+ */
+static inline Vehicle *GetTileHashBucket(uint hash, VehicleType type)
+{
+	if (type == VEH_INVALID) return _vehicle_tile_hash[hash];
+	assert(type < VEH_COMPANY_END);
+	return _vehicle_type_tile_hash[type][hash];
+}
+
+/**
+ * Get the next vehicle in the tile hash chain.
+ * @param v The current vehicle.
+ * @param type The vehicle type of the chain, or #VEH_INVALID for the chain of all vehicles.
+ * @return The next vehicle in the chain.
+ */
+static inline Vehicle *GetTileHashNext(const Vehicle *v, VehicleType type)
+{
+	return type == VEH_INVALID ? v->hash_tile_next : v->hash_type_tile_next;
+}
+
 /**
  * Iterator constructor.
  * Find first vehicle near (x, y).
  */
-VehiclesNearTileXY::Iterator::Iterator(int32_t x, int32_t y, uint max_dist)
+VehiclesNearTileXY::Iterator::Iterator(int32_t x, int32_t y, uint max_dist, VehicleType type) : type(type)
 {
 	/* There are no negative tile coordinates */
 	this->pos_rect.left = std::max<int>(0, x - max_dist);
@@ -451,7 +494,7 @@ VehiclesNearTileXY::Iterator::Iterator(int32_t x, int32_t y, uint max_dist)
 		this->hymax = TILE_HASH_MASK;
 	}
 
-	this->current_veh = _vehicle_tile_hash[ComposeTileHash(this->hx, this->hy)];
+	this->current_veh = GetTileHashBucket(ComposeTileHash(this->hx, this->hy), this->type);
 	this->SkipEmptyBuckets();
 	this->SkipFalseMatches();
 }
@@ -462,7 +505,7 @@ VehiclesNearTileXY::Iterator::Iterator(int32_t x, int32_t y, uint max_dist)
 void VehiclesNearTileXY::Iterator::Increment()
 {
 	assert(this->current_veh != nullptr);
-	this->current_veh = this->current_veh->hash_tile_next;
+	this->current_veh = GetTileHashNext(this->current_veh, this->type);
 	this->SkipEmptyBuckets();
 }
 
@@ -480,7 +523,7 @@ void VehiclesNearTileXY::Iterator::SkipEmptyBuckets()
 		} else {
 			return;
 		}
-		this->current_veh = _vehicle_tile_hash[ComposeTileHash(this->hx, this->hy)];
+		this->current_veh = GetTileHashBucket(ComposeTileHash(this->hx, this->hy), this->type);
 	}
 }
 
@@ -496,9 +539,9 @@ void VehiclesNearTileXY::Iterator::SkipFalseMatches()
  * Iterator constructor.
  * Find first vehicle on tile.
  */
-VehiclesOnTile::Iterator::Iterator(TileIndex tile) : tile(tile)
+VehiclesOnTile::Iterator::Iterator(TileIndex tile, VehicleType type) : tile(tile), type(type)
 {
-	this->current = _vehicle_tile_hash[GetTileHash(TileX(tile), TileY(tile))];
+	this->current = GetTileHashBucket(GetTileHash(TileX(tile), TileY(tile)), type);
 	this->SkipFalseMatches();
 }
 
@@ -508,7 +551,7 @@ VehiclesOnTile::Iterator::Iterator(TileIndex tile) : tile(tile)
  */
 void VehiclesOnTile::Iterator::Increment()
 {
-	this->current = this->current->hash_tile_next;
+	this->current = GetTileHashNext(this->current, this->type);
 }
 
 /**
@@ -618,10 +661,33 @@ static void UpdateVehicleTileHash(Vehicle *v, bool remove)
 
 	/* Remember current hash position */
 	v->hash_tile_current = new_hash;
+
+	if (v->type >= VEH_COMPANY_END) return;
+
+	/* Keep the hash of the vehicle's type in the same bucket */
+	if (old_hash != nullptr) {
+		if (v->hash_type_tile_next != nullptr) v->hash_type_tile_next->hash_type_tile_prev = v->hash_type_tile_prev;
+		*v->hash_type_tile_prev = v->hash_type_tile_next;
+	}
+
+	if (new_hash != nullptr) {
+		Vehicle **type_hash = &_vehicle_type_tile_hash[v->type][new_hash - _vehicle_tile_hash.data()];
+		v->hash_type_tile_next = *type_hash;
+		if (v->hash_type_tile_next != nullptr) v->hash_type_tile_next->hash_type_tile_prev = &v->hash_type_tile_next;
+		v->hash_type_tile_prev = type_hash;
+		*type_hash = v;
+	}
 }
 
 static std::array<Vehicle *, 1 << (GEN_HASHX_BITS + GEN_HASHY_BITS)> _vehicle_viewport_hash{};
 
+/**
+ * Vehicle whose parts are currently moving; their viewport updates are collected
+ * and performed once after all movement steps of the tick.
+ * @see SpecializedVehicle::UpdateViewportAfterMovement
+ */
+const Vehicle *_vehicle_viewport_update_batch = nullptr;
+
 static void UpdateVehicleViewportHash(Vehicle *v, int x, int y, int old_x, int old_y)
 {
 	Vehicle **old_hash, **new_hash;
@@ -651,6 +717,7 @@ void ResetVehicleHash()
 	for (Vehicle *v : Vehicle::Iterate()) { v->hash_tile_current = nullptr; }
 	_vehicle_viewport_hash.fill(nullptr);
 	_vehicle_tile_hash.fill(nullptr);
+	for (auto &type_hash : _vehicle_type_tile_hash) type_hash.fill(nullptr);
 }
 
 void ResetVehicleColourMap()
@@ -908,6 +975,8 @@ void RunVehicleCalendarDayProc()
 {
 	if (_game_mode != GM_NORMAL) return;
 
+	PerformanceAccumulator framerate(PFE_GL_DAYPROCS);
+
 	/* Run the calendar day proc for every DAY_TICKS vehicle starting at TimerGameCalendar::date_fract. */
 	for (size_t i = TimerGameCalendar::date_fract; i < Vehicle::GetPoolSize(); i += Ticks::DAY_TICKS) {
 		Vehicle *v = Vehicle::Get(i);
@@ -925,6 +994,8 @@ static void RunEconomyVehicleDayProc()
 {
 	if (_game_mode != GM_NORMAL) return;
 
+	PerformanceAccumulator framerate(PFE_GL_DAYPROCS);
+
 	/* Run the economy day proc for every DAY_TICKS vehicle starting at TimerGameEconomy::date_fract. */
 	for (size_t i = TimerGameEconomy::date_fract; i < Vehicle::GetPoolSize(); i += Ticks::DAY_TICKS) {
 		Vehicle *v = Vehicle::Get(i);
@@ -951,8 +1022,62 @@ static void RunEconomyVehicleDayProc()
 	}
 }
 
+/**
+ * Check whether a vehicle is asleep, i.e. its tick handler would do nothing
+ * but advance its counters. This is the case for primary vehicles that are
+ * stopped, standing still and have nothing pending, like vehicles stopped in
+ * a depot. Being checked every tick, any change to the vehicle (it is started,
+ * breaks down, gets crashed) wakes it up immediately.
+ * Vehicles waiting to load already wait for their load_unload_ticks instead.
+ * @param v The vehicle to check.
+ * @return True iff the vehicle can be ticked by #TickAsleepVehicle.
+ */
+static bool IsVehicleAsleep(const Vehicle *v)
+{
+	if (!v->vehstatus.Test(VehState::Stopped) || v->vehstatus.Test(VehState::Crashed)) return false;
+	if (v->cur_speed != 0 || v->breakdown_ctr != 0) return false;
+
+	switch (v->type) {
+		case VEH_TRAIN: {
+			const Train *t = Train::From(v);
+			return t->IsFrontEngine() && t->force_proceed == TFP_NONE && !t->flags.Test(VehicleRailFlag::Reversing);
+		}
+
+		case VEH_ROAD: {
+			/* Outside of a depot a stopped road vehicle can still be hit by a train. */
+			const RoadVehicle *rv = RoadVehicle::From(v);
+			return rv->IsFrontEngine() && rv->reverse_ctr == 0 && rv->gcache.last_speed == rv->cur_speed && rv->IsChainInDepot();
+		}
+
+		case VEH_SHIP:
+			return true;
+
+		case VEH_AIRCRAFT: {
+			/* Visible helicopter rotors keep turning until they stopped. */
+			const Aircraft *a = Aircraft::From(v);
+			return a->IsNormalAircraft() && (a->subtype != AIR_HELICOPTER || a->Next()->Next()->vehstatus.Test(VehState::Hidden));
+		}
+
+		default:
+			return false;
+	}
+}
+
+/**
+ * Tick a vehicle that is asleep. This does what the vehicle's tick handler
+ * would have done, without running the full handler.
+ * @param v The vehicle to tick.
+ */
+static void TickAsleepVehicle(Vehicle *v)
+{
+	v->tick_counter++;
+	v->current_order_time++;
+}
+
 void CallVehicleTicks()
 {
+	PerformanceTraceScope trace("Vehicle ticks");
+
 	_vehicles_to_autoreplace.clear();
 
 	RunEconomyVehicleDayProc();
@@ -970,7 +1095,9 @@ void CallVehicleTicks()
 		[[maybe_unused]] VehicleID vehicle_index = v->index;
 
 		/* Vehicle could be deleted in this tick */
-		if (!v->Tick()) {
+		if (IsVehicleAsleep(v)) {
+			TickAsleepVehicle(v);
+		} else if (!v->Tick()) {
 			assert(Vehicle::Get(vehicle_index) == nullptr);
 			continue;
 		}
@@ -1715,6 +1842,9 @@ void Vehicle::UpdateBoundingBoxCoordinates(bool update_cache) const
  */
 void Vehicle::UpdateViewport(bool dirty)
 {
+	/* Nothing is ever drawn on dedicated servers without screen */
+	if (_network_dedicated) return;
+
 	/* If the existing cache is invalid we should ignore it, as it will be set to the current coords by UpdateBoundingBoxCoordinates */
 	bool ignore_cached_coords = this->sprite_cache.old_coord.left == INVALID_COORD;
 
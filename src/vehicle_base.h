@@ -178,6 +178,9 @@ struct MutableSpriteCache {
 	Direction last_direction = INVALID_DIR; ///< Last direction we obtained sprites for
 	bool revalidate_before_draw = false; ///< We need to do a GetImage() and check bounds before drawing this sprite
 	bool is_viewport_candidate = false; ///< This vehicle can potentially be drawn on a viewport
+	bool pending_update = false; ///< A viewport update was collected while the vehicle was moving
+	bool pending_force_update = false; ///< The collected viewport update must update the vehicle on the viewport
+	bool pending_update_delta = false; ///< The collected viewport update must update the delta
 	Rect old_coord{}; ///< Co-ordinates from the last valid bounding box
 	VehicleSpriteSeq sprite_seq{}; ///< Vehicle appearance.
 };
@@ -186,6 +189,8 @@ struct MutableSpriteCache {
 typedef Pool<Vehicle, VehicleID, 512> VehiclePool;
 extern VehiclePool _vehicle_pool;
 
+extern const Vehicle *_vehicle_viewport_update_batch;
+
 /* Some declarations of functions, so we can make them friendly */
 struct GroundVehicleCache;
 struct LoadgameState;
@@ -266,6 +271,9 @@ public:
 	Vehicle **hash_tile_prev = nullptr; ///< NOSAVE: Previous vehicle in the tile location hash.
 	Vehicle **hash_tile_current = nullptr; ///< NOSAVE: Cache of the current hash chain.
 
+	Vehicle *hash_type_tile_next = nullptr; ///< NOSAVE: Next vehicle in the tile location hash of this vehicle type.
+	Vehicle **hash_type_tile_prev = nullptr; ///< NOSAVE: Previous vehicle in the tile location hash of this vehicle type.
+
 	SpriteID colourmap{}; ///< NOSAVE: cached colour mapping
 
 	/* Related to age and service time */
@@ -770,6 +778,7 @@ public:
 
 	bool NeedsAutorenewing(const Company *c, bool use_renew_setting = true) const;
 
+	bool IsServiceIntervalElapsed() const;
 	bool NeedsServicing() const;
 	bool NeedsAutomaticServicing() const;
 
@@ -1179,6 +1188,14 @@ struct SpecializedVehicle : public Vehicle {
 		/* Skip updating sprites on dedicated servers without screen */
 		if (_network_dedicated) return;
 
+		/* The vehicle is still moving this tick, only update the viewport once it stopped. */
+		if (this->First() == _vehicle_viewport_update_batch) {
+			this->sprite_cache.pending_update = true;
+			this->sprite_cache.pending_force_update |= force_update;
+			this->sprite_cache.pending_update_delta |= update_delta;
+			return;
+		}
+
 		/* Explicitly choose method to call to prevent vtable dereference -
 		 * it gives ~3% runtime improvements in games with many vehicles */
 		if (update_delta) ((T *)this)->T::UpdateDeltaXY();
@@ -1214,6 +1231,25 @@ struct SpecializedVehicle : public Vehicle {
 		}
 	}
 
+	/**
+	 * Update the viewport after the vehicle finished moving for this tick.
+	 * Performs the viewport update collected while moving, or when the vehicle did not
+	 * move only checks whether the sprite of a visible vehicle has changed.
+	 */
+	inline void UpdateViewportAfterMovement()
+	{
+		if (this->sprite_cache.pending_update) {
+			bool force_update = this->sprite_cache.pending_force_update;
+			bool update_delta = this->sprite_cache.pending_update_delta;
+			this->sprite_cache.pending_update = false;
+			this->sprite_cache.pending_force_update = false;
+			this->sprite_cache.pending_update_delta = false;
+			this->UpdateViewport(force_update, update_delta);
+		} else if (!this->vehstatus.Test(VehState::Hidden)) {
+			this->UpdateViewport(false, false);
+		}
+	}
+
 	/**
 	 * Returns an iterable ensemble of all valid vehicles of type T
 	 * @param from index of the first vehicle to consider
@@ -48,6 +48,7 @@ bool IsValidImageIndex(uint8_t image_index);
 
 /**
  * Iterate over all vehicles on a tile.
+ * When a company vehicle type is given, only vehicles of that type are visited.
  * @warning The order is non-deterministic. You have to make sure, that your processing is not order dependant.
  */
 class VehiclesOnTile {
@@ -63,7 +64,7 @@ public:
 		using pointer = void;
 		using reference = void;
 
-		explicit Iterator(TileIndex tile);
+		explicit Iterator(TileIndex tile, VehicleType type);
 
 		bool operator==(const Iterator &rhs) const { return this->current == rhs.current; }
 		bool operator==(const std::default_sentinel_t &) const { return this->current == nullptr; }
@@ -85,13 +86,14 @@ public:
 		}
 	private:
 		TileIndex tile;
+		VehicleType type;
 		Vehicle *current;
 
 		void Increment();
 		void SkipFalseMatches();
 	};
 
-	explicit VehiclesOnTile(TileIndex tile) : start(tile) {}
+	explicit VehiclesOnTile(TileIndex tile, VehicleType type = VEH_INVALID) : start(tile, type) {}
 	Iterator begin() const { return this->start; }
 	std::default_sentinel_t end() const { return std::default_sentinel_t(); }
 private:
@@ -111,8 +113,22 @@ bool HasVehicleOnTile(TileIndex tile, UnaryPred &&predicate)
 	return false;
 }
 
+/**
+ * Loop over vehicles of a single company vehicle type on a tile, and check whether a predicate is true for any of them.
+ * The predicate must have the signature: bool Predicate(const Vehicle *);
+ */
+template <class UnaryPred>
+bool HasVehicleOnTile(TileIndex tile, VehicleType type, UnaryPred &&predicate)
+{
+	for (const auto *v : VehiclesOnTile(tile, type)) {
+		if (predicate(v)) return true;
+	}
+	return false;
+}
+
 /**
  * Iterate over all vehicles near a given world coordinate.
+ * When a company vehicle type is given, only vehicles of that type are visited.
  * @warning This only works for vehicles with proper Vehicle::Tile, so only ground vehicles outside wormholes.
  * @warning The order is non-deterministic. You have to make sure, that your processing is not order dependant.
  */
@@ -129,7 +145,7 @@ public:
 		using pointer = void;
 		using reference = void;
 
-		explicit Iterator(int32_t x, int32_t y, uint max_dist);
+		explicit Iterator(int32_t x, int32_t y, uint max_dist, VehicleType type);
 
 		bool operator==(const Iterator &rhs) const { return this->current_veh == rhs.current_veh; }
 		bool operator==(const std::default_sentinel_t &) const { return this->current_veh == nullptr; }
@@ -153,6 +169,7 @@ public:
 		Rect pos_rect;
 		uint hxmin, hxmax, hymin, hymax;
 		uint hx, hy;
+		VehicleType type;
 		Vehicle *current_veh;
 
 		void Increment();
@@ -160,7 +177,7 @@ public:
 		void SkipFalseMatches();
 	};
 
-	explicit VehiclesNearTileXY(int32_t x, int32_t y, uint max_dist) : start(x, y, max_dist) {}
+	explicit VehiclesNearTileXY(int32_t x, int32_t y, uint max_dist, VehicleType type = VEH_INVALID) : start(x, y, max_dist, type) {}
 	Iterator begin() const { return this->start; }
 	std::default_sentinel_t end() const { return std::default_sentinel_t(); }
 private:
@@ -181,6 +198,20 @@ bool HasVehicleNearTileXY(int32_t x, int32_t y, uint max_dist, UnaryPred &&predi
 	return false;
 }
 
+/**
+ * Loop over vehicles of a single company vehicle type near a given world coordinate, and check whether a predicate is true for any of them.
+ * The predicate must have the signature: bool Predicate(const Vehicle *);
+ * @warning This only works for vehicles with proper Vehicle::Tile, so only ground vehicles outside wormholes.
+ */
+template <class UnaryPred>
+bool HasVehicleNearTileXY(int32_t x, int32_t y, uint max_dist, VehicleType type, UnaryPred &&predicate)
+{
+	for (const auto *v : VehiclesNearTileXY(x, y, max_dist, type)) {
+		if (predicate(v)) return true;
+	}
+	return false;
+}
+
 void VehicleServiceInDepot(Vehicle *v);
 uint CountVehiclesInChain(const Vehicle *v);
 void CallVehicleTicks();
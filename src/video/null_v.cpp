@@ -12,8 +12,17 @@
 #include "../blitter/factory.hpp"
 #include "../saveload/saveload.h"
 #include "../window_func.h"
+#include "../framerate_type.h"
+#include "../openttd.h"
+#include "../state_hash.h"
+#include "../network/network_func.h"
+#include "../network/network_replay.h"
+#include "../core/random_func.hpp"
+#include "../timer/timer_game_economy.h"
 #include "null_v.h"
 
+#include <chrono>
+
 #include "../safeguards.h"
 
 /** Factory for the null video driver. */
@@ -31,6 +40,10 @@ std::optional<std::string_view> VideoDriver_Null::Start(const StringList &parm)
 	this->UpdateAutoResolution();
 
 	this->ticks = GetDriverParamInt(parm, "ticks", 1000);
+	this->benchmark = GetDriverParamBool(parm, "benchmark");
+	this->replay = GetDriverParam(parm, "replay").value_or("");
+	/* Scripts must not run during the replay, and order backups must be kept when loading the game. */
+	if (this->benchmark && !this->replay.empty()) _network_replaying_commands = true;
 	_screen.width  = _screen.pitch = _cur_resolution.width;
 	_screen.height = _cur_resolution.height;
 	_screen.dst_ptr = nullptr;
@@ -46,8 +59,58 @@ void VideoDriver_Null::Stop() { }
 
 void VideoDriver_Null::MakeDirty(int, int, int, int) {}
 
+/**
+ * Run the game state loop for the requested number of ticks without any
+ * throttling, networking or drawing, and print how fast that went.
+ * This allows measuring the simulation performance of a savegame reproducibly.
+ * When a desync log is given, its commands are replayed and its sync states
+ * checked, so a recorded session can be used as benchmark as well.
+ */
+void VideoDriver_Null::RunBenchmark()
+{
+	/* Let the game loop switch to the game to benchmark first. */
+	::GameLoop();
+	if (_exit_game) return;
+
+	CommandLogReplay replay;
+	if (!this->replay.empty() && !replay.Load(this->replay)) {
+		fmt::print("Benchmark: cannot open {}\n", this->replay);
+		return;
+	}
+
+	if (_pause_mode.Any()) {
+		fmt::print("Benchmark: unpausing the game\n");
+		_pause_mode = {};
+	}
+
+	ResetPerformanceTotals();
+	auto start = std::chrono::steady_clock::now();
+	uint ticks = 0;
+	for (; ticks < this->ticks; ticks++) {
+		if (!replay.Replay()) {
+			fmt::print("Benchmark: sync state mismatch after {} ticks\n", ticks);
+			break;
+		}
+		::StateGameLoop();
+	}
+	auto duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+
+	fmt::print("Benchmark: {} ticks in {:.3f}s, {:.2f} ticks/s\n", ticks, duration.count(), ticks / duration.count());
+	if (!this->replay.empty()) {
+		fmt::print("Benchmark: replayed {} commands, {} sync states matched, {} entries skipped{}\n",
+				replay.commands, replay.sync_checks, replay.skipped, replay.IsFinished() ? "" : ", log not finished");
+	}
+	PrintPerformanceTotals(ticks);
+	fmt::print("Benchmark: final date {}, random state {:08x} {:08x}, state hash {:08x}\n", TimerGameEconomy::date, _random.state[0], _random.state[1], CombineStateHash(CalculateStateHash()));
+}
+
 void VideoDriver_Null::MainLoop()
 {
+	if (this->benchmark) {
+		this->RunBenchmark();
+		return;
+	}
+
 	uint i;
 
 	for (i = 0; i < this->ticks; i++) {
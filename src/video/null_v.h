@@ -16,6 +16,10 @@
 class VideoDriver_Null : public VideoDriver {
 private:
 	uint ticks = 0; ///< Amount of ticks to run.
+	bool benchmark = false; ///< Whether to only run the game state loop as fast as possible, and report its performance.
+	std::string replay; ///< Desync log to replay the commands of while benchmarking.
+
+	void RunBenchmark();
 
 public:
 	std::optional<std::string_view> Start(const StringList &param) override;
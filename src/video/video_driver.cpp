@@ -29,11 +29,17 @@ bool _video_vsync; ///< Whether we should use vsync (only if active video driver
 
 void VideoDriver::GameLoop()
 {
-	this->next_game_tick += this->GetGameInterval();
+	auto now = std::chrono::steady_clock::now();
+	this->game_lag = std::max<std::chrono::steady_clock::duration>(now - this->next_game_tick, {});
+
+	auto interval = this->GetGameInterval();
+	this->next_game_tick += interval;
 
 	/* Avoid next_game_tick getting behind more and more if it cannot keep up. */
-	auto now = std::chrono::steady_clock::now();
-	if (this->next_game_tick < now - ALLOWED_DRIFT * this->GetGameInterval()) this->next_game_tick = now;
+	if (this->next_game_tick < now - ALLOWED_DRIFT * interval) {
+		if (interval.count() > 0) this->skipped_game_ticks += (now - this->next_game_tick) / interval;
+		this->next_game_tick = now;
+	}
 
 	{
 		std::lock_guard<std::mutex> lock(this->game_state_mutex);
@@ -311,6 +311,22 @@ protected:
 	 */
 	void SleepTillNextTick();
 
+public:
+	/**
+	 * Get how late the last game tick started compared to when it was scheduled.
+	 * @return The lag of the game loop.
+	 */
+	std::chrono::steady_clock::duration GetGameLag() const { return this->game_lag; }
+
+	/**
+	 * Get the number of game ticks that were given up on, as the game loop could
+	 * not keep up and was too far behind to catch up.
+	 * @return The number of skipped ticks.
+	 */
+	uint64_t GetSkippedGameTicks() const { return this->skipped_game_ticks; }
+
+protected:
+
 	std::chrono::steady_clock::duration GetGameInterval()
 	{
 #ifdef DEBUG_DUMP_COMMANDS
@@ -358,6 +374,8 @@ protected:
 
 	std::chrono::steady_clock::time_point next_game_tick;
 	std::chrono::steady_clock::time_point next_draw_tick;
+	std::chrono::steady_clock::duration game_lag{}; ///< How late the last game tick started.
+	uint64_t skipped_game_ticks = 0; ///< Number of game ticks that were given up on, as the game loop could not keep up.
 
 	bool fast_forward_key_pressed; ///< The fast-forward key is being pressed.
 	bool fast_forward_via_key; ///< The fast-forward was enabled by key press.